@@ -0,0 +1,56 @@
+#include "AllocCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace sevens {
+namespace alloc_counter {
+
+namespace {
+std::atomic<bool>      g_enabled{false};
+thread_local Snapshot  t_counts;
+} // namespace
+
+void enable(bool on) { g_enabled.store(on, std::memory_order_relaxed); }
+
+bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+Snapshot thisThread() { return t_counts; }
+
+// Appelé par chaque operator new remplacé ci-dessous
+static inline void record(std::size_t size)
+{
+    if (g_enabled.load(std::memory_order_relaxed)) {
+        ++t_counts.allocations;
+        t_counts.bytes += size;
+    }
+}
+
+} // namespace alloc_counter
+} // namespace sevens
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Remplacement de l'allocateur global (les formes tableau et nothrow de la
+// bibliothèque standard se rabattent sur celles-ci)
+void* operator new(std::size_t size)
+{
+    sevens::alloc_counter::record(size);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    sevens::alloc_counter::record(size);
+    const std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, size ? (size + a - 1) / a * a : a))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sevens {
+
+/**
+ * Opt-in count of global operator new calls, per thread.
+ *
+ * AllocCounter.cpp replaces the global operator new/delete of the engine
+ * binary. Strategy plugins are dlopen()ed into the same process and resolve
+ * operator new to it, so their allocations are counted too. Counting costs
+ * one relaxed load per allocation while disabled.
+ */
+namespace alloc_counter {
+
+struct Snapshot {
+    uint64_t allocations = 0;
+    uint64_t bytes       = 0;
+};
+
+void     enable(bool on);
+bool     enabled();
+Snapshot thisThread();   // running totals of the calling thread
+
+} // namespace alloc_counter
+
+} // namespace sevens
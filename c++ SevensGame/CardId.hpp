@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+namespace sevens {
+
+/**
+ * One-byte card identity: value = suit * 13 + (rank - 1), i.e. 0..51, the
+ * same numbering as MyCardParser's card IDs and the bit index used by the
+ * bitmask helpers (OpponentBeliefs, GameFeatures).
+ *
+ * Suit, rank, display name and bit are read from constexpr tables, so
+ * converting to and from the legacy two-int Card costs nothing at runtime.
+ */
+struct CardId {
+    static constexpr int NUM_CARDS = 52;
+
+    uint8_t value = 0;
+
+    constexpr CardId() = default;
+    constexpr explicit CardId(uint8_t v) : value(v) { }
+    constexpr CardId(int suit, int rank)
+        : value(static_cast<uint8_t>(suit * 13 + (rank - 1))) { }
+    // Implicit, so legacy Card values can be passed wherever a CardId is expected
+    constexpr CardId(const Card& c) : CardId(c.suit, c.rank) { }
+
+    constexpr int         suit() const;
+    constexpr int         rank() const;
+    constexpr uint64_t    bit()  const { return uint64_t{1} << value; }
+    constexpr const char* name() const;   // e.g. "7D", "TH", "AS"
+    constexpr Card        toCard() const { return Card{suit(), rank()}; }
+
+    constexpr bool operator==(CardId o) const { return value == o.value; }
+    constexpr bool operator!=(CardId o) const { return value != o.value; }
+    constexpr bool operator< (CardId o) const { return value <  o.value; }
+
+    friend std::ostream& operator<<(std::ostream& os, CardId c) { return os << c.name(); }
+};
+
+static_assert(sizeof(CardId) == 1, "CardId must stay one byte");
+
+namespace card_tables {
+
+inline constexpr char SUIT_CHARS[] = "CDHS";   // Clubs, Diamonds, Hearts, Spades
+inline constexpr char RANK_CHARS[] = "A23456789TJQK";
+
+struct Catalogue {
+    uint8_t suit[CardId::NUM_CARDS];
+    uint8_t rank[CardId::NUM_CARDS];
+    char    name[CardId::NUM_CARDS][3];
+};
+
+constexpr Catalogue makeCatalogue() {
+    Catalogue t{};
+    for (int id = 0; id < CardId::NUM_CARDS; ++id) {
+        t.suit[id]    = static_cast<uint8_t>(id / 13);
+        t.rank[id]    = static_cast<uint8_t>(id % 13 + 1);
+        t.name[id][0] = RANK_CHARS[id % 13];
+        t.name[id][1] = SUIT_CHARS[id / 13];
+        t.name[id][2] = '\0';
+    }
+    return t;
+}
+
+inline constexpr Catalogue CATALOGUE = makeCatalogue();
+
+constexpr std::array<CardId, CardId::NUM_CARDS> makeDeck() {
+    std::array<CardId, CardId::NUM_CARDS> d{};
+    for (int id = 0; id < CardId::NUM_CARDS; ++id)
+        d[id] = CardId(static_cast<uint8_t>(id));
+    return d;
+}
+
+} // namespace card_tables
+
+constexpr int         CardId::suit() const { return card_tables::CATALOGUE.suit[value]; }
+constexpr int         CardId::rank() const { return card_tables::CATALOGUE.rank[value]; }
+constexpr const char* CardId::name() const { return card_tables::CATALOGUE.name[value]; }
+
+// The full deck in ID order, built at compile time
+inline constexpr std::array<CardId, CardId::NUM_CARDS> FULL_DECK = card_tables::makeDeck();
+
+// The 7♦ is on the table before anyone plays
+inline constexpr CardId SEVEN_OF_DIAMONDS{1, 7};
+
+// ── 52-bit card sets (bit = CardId value) ───────────────────────────────────
+namespace card_masks {
+
+inline constexpr uint64_t ALL    = (uint64_t{1} << CardId::NUM_CARDS) - 1;
+inline constexpr uint64_t ACES   = uint64_t{1} | uint64_t{1} << 13 | uint64_t{1} << 26 | uint64_t{1} << 39;
+inline constexpr uint64_t KINGS  = ACES << 12;
+inline constexpr uint64_t SEVENS = ACES << 6;
+
+constexpr uint64_t suit(int s) { return uint64_t{0x1FFF} << (13 * s); }
+
+// Cards legal on `table`: neighbours of placed cards in the same suit, or a 7
+constexpr uint64_t legal(uint64_t table) {
+    return (((table & ~KINGS) << 1) | ((table & ~ACES) >> 1) | SEVENS) & ~table & ALL;
+}
+
+} // namespace card_masks
+
+static_assert(SEVEN_OF_DIAMONDS.value == 19 && SEVEN_OF_DIAMONDS.name()[0] == '7' &&
+              SEVEN_OF_DIAMONDS.name()[1] == 'D', "card catalogue layout");
+
+} // namespace sevens
@@ -0,0 +1,115 @@
+#include "Checkpoint.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+constexpr char     MAGIC[4] = {'S', 'V', 'C', 'K'};
+constexpr uint32_t VERSION  = 1;
+
+// Écrit un entier non signé en little-endian sur `bytes` octets
+void put(std::string& out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+// Lecture séquentielle d'un tampon, avec contrôle de débordement
+struct Reader {
+    const std::string& buf;
+    std::size_t pos = 0;
+
+    uint64_t get(int bytes) {
+        if (pos + bytes > buf.size())
+            throw std::runtime_error("checkpoint truncated");
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i)
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(buf[pos++])) << (8 * i);
+        return v;
+    }
+
+    std::string bytes(std::size_t n) {
+        if (pos + n > buf.size())
+            throw std::runtime_error("checkpoint truncated");
+        std::string s = buf.substr(pos, n);
+        pos += n;
+        return s;
+    }
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sauvegarde atomique : fichier temporaire + fsync + rename
+void TournamentCheckpoint::save(const std::string& path) const
+{
+    std::string out(MAGIC, sizeof MAGIC);
+    put(out, VERSION, 4);
+    put(out, seed, 8);
+    put(out, gamesTotal, 8);
+    put(out, gamesDone, 8);
+    put(out, tallies.size(), 4);
+    for (const auto& t : tallies) {
+        put(out, t.name.size(), 2);
+        out += t.name;
+        put(out, t.games, 8);
+        put(out, t.wins, 8);
+        put(out, t.points, 8);
+    }
+
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f)
+        throw std::runtime_error("cannot write checkpoint " + tmp);
+
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size()
+           && std::fflush(f) == 0
+           && ::fsync(fileno(f)) == 0;
+    ok = (std::fclose(f) == 0) && ok;
+
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("cannot write checkpoint " + path);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Relit un point de reprise écrit par save()
+TournamentCheckpoint TournamentCheckpoint::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("cannot open checkpoint " + path);
+    const std::string buf((std::istreambuf_iterator<char>(in)),
+                          std::istreambuf_iterator<char>());
+
+    Reader r{buf};
+    if (r.bytes(sizeof MAGIC) != std::string(MAGIC, sizeof MAGIC))
+        throw std::runtime_error(path + " is not a checkpoint file");
+    if (r.get(4) != VERSION)
+        throw std::runtime_error("unsupported checkpoint version in " + path);
+
+    TournamentCheckpoint cp;
+    cp.seed       = r.get(8);
+    cp.gamesTotal = r.get(8);
+    cp.gamesDone  = r.get(8);
+    const uint64_t nPlayers = r.get(4);
+    if (nPlayers * 26 > buf.size() - r.pos)   // 26 = taille minimale d'une entrée
+        throw std::runtime_error("checkpoint truncated");
+    cp.tallies.resize(nPlayers);
+    for (auto& t : cp.tallies) {
+        t.name   = r.bytes(r.get(2));
+        t.games  = r.get(8);
+        t.wins   = r.get(8);
+        t.points = r.get(8);
+    }
+    return cp;
+}
+
+} // namespace sevens
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Accumulated results of one seat over a series of games.
+ */
+struct PlayerTally {
+    std::string name;         // label shown by main, e.g. "SmartSevens-0"
+    uint64_t    games  = 0;   // games played
+    uint64_t    wins   = 0;   // games finished with the lowest score (ties count)
+    uint64_t    points = 0;   // sum of final scores (lower = better)
+};
+
+/**
+ * Progress of a long series of games, saved periodically so that a killed
+ * run can continue with --resume.
+ *
+ * The shuffling RNG is not stored as such: game #i is always dealt from
+ * MyGameMapper::reseed(seed, i), so (seed, gamesDone) is the whole RNG state.
+ *
+ * File layout (little-endian, all integers u64 unless noted):
+ *   "SVCK" | u32 version | seed | gamesTotal | gamesDone | u32 nPlayers
+ *   then per player: u16 nameLen | name bytes | games | wins | points
+ */
+struct TournamentCheckpoint {
+    uint64_t seed       = 0;
+    uint64_t gamesTotal = 0;
+    uint64_t gamesDone  = 0;
+    std::vector<PlayerTally> tallies;   // index = player ID
+
+    // Writes to "<path>.tmp", syncs it, then renames over path, so the file
+    // on disk is always either the previous or the new checkpoint.
+    void save(const std::string& path) const;
+
+    // Throws std::runtime_error if the file is missing or malformed.
+    static TournamentCheckpoint load(const std::string& path);
+};
+
+} // namespace sevens
@@ -0,0 +1,177 @@
+#include "DealAnalyzer.hpp"
+#include "CardId.hpp"
+#include "MyGameMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace sevens {
+
+namespace {
+
+constexpr double Z95 = 1.96;
+constexpr uint64_t CHUNK = 16;   // parties réservées à la fois par un thread
+
+// Sommes par siège pour une ligne (jeu libre ou ouverture imposée)
+struct Tally {
+    double left  = 0;
+    double left2 = 0;
+    double wins  = 0;
+};
+
+SeatOutcome summarise(const Tally& t, uint64_t n)
+{
+    SeatOutcome o;
+    if (n == 0) return o;
+    const double nn = static_cast<double>(n);
+    o.meanLeft = t.left / nn;
+    const double var = n > 1 ? std::max(0.0, (t.left2 - nn * o.meanLeft * o.meanLeft) / (nn - 1)) : 0.0;
+    o.leftError = Z95 * std::sqrt(var / nn);
+
+    // Intervalle de Wilson (les victoires partagées comptent pour une fraction)
+    const double p = t.wins / nn, z2 = Z95 * Z95;
+    const double centre = (p + z2 / (2 * nn)) / (1 + z2 / nn);
+    const double half   = Z95 * std::sqrt(p * (1 - p) / nn + z2 / (4 * nn * nn)) / (1 + z2 / nn);
+    o.winProb = p;
+    o.winLow  = std::max(0.0, centre - half);
+    o.winHigh = std::min(1.0, centre + half);
+    return o;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rejoue la donne `samples` fois par ligne (jeu libre + chaque ouverture)
+DealAnalysis analyze_deal(const std::vector<std::vector<Card>>& hands,
+                          const StrategyFactory& makeStrategy,
+                          uint64_t samples, unsigned threads)
+{
+    const std::size_t nSeats = hands.size();
+    if (nSeats < 2)
+        throw std::invalid_argument("a deal needs at least 2 seats");
+
+    // Ouvertures possibles du siège 0 : ses cartes jouables sur le 7♦ seul
+    std::vector<Card> openings;
+    for (const auto& c : hands[0])
+        if (card_masks::legal(SEVEN_OF_DIAMONDS.bit()) & CardId(c).bit())
+            openings.push_back(c);
+    if (openings.size() < 2)
+        openings.clear();
+
+    const std::size_t nLines = 1 + openings.size();
+    const uint64_t total = samples * nLines;
+    std::vector<Tally> tallies(nLines * nSeats);
+    std::atomic<uint64_t> next{0};
+    std::mutex mtx;
+    std::exception_ptr failure;
+
+    auto worker = [&] {
+        try {
+            MyGameMapper mapper;
+            mapper.read_cards("");
+            mapper.read_game("");
+            for (std::size_t s = 0; s < nSeats; ++s)
+                mapper.registerStrategy(s, makeStrategy(s));
+
+            std::vector<Tally> local(tallies.size());
+            for (uint64_t begin; (begin = next.fetch_add(CHUNK)) < total; ) {
+                const uint64_t end = std::min(total, begin + CHUNK);
+                for (uint64_t k = begin; k < end; ++k) {
+                    const std::size_t line = k / samples;
+                    const auto left = line == 0
+                        ? mapper.play_deal(hands)
+                        : mapper.play_deal(hands, openings[line - 1]);
+
+                    const uint64_t best = *std::min_element(left.begin(), left.end());
+                    const double share = 1.0 / static_cast<double>(std::count(left.begin(), left.end(), best));
+                    for (std::size_t s = 0; s < nSeats; ++s) {
+                        Tally& t = local[line * nSeats + s];
+                        const double l = static_cast<double>(left[s]);
+                        t.left  += l;
+                        t.left2 += l * l;
+                        if (left[s] == best) t.wins += share;
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            for (std::size_t i = 0; i < tallies.size(); ++i) {
+                tallies[i].left  += local[i].left;
+                tallies[i].left2 += local[i].left2;
+                tallies[i].wins  += local[i].wins;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!failure) failure = std::current_exception();
+            next = total;   // les autres threads s'arrêtent aussi
+        }
+    };
+
+    const unsigned nThreads = std::max(1u, threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < nThreads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool)
+        th.join();
+    if (failure)
+        std::rethrow_exception(failure);
+
+    DealAnalysis res;
+    res.samples = samples;
+    for (std::size_t s = 0; s < nSeats; ++s)
+        res.seats.push_back(summarise(tallies[s], samples));
+    for (std::size_t o = 0; o < openings.size(); ++o) {
+        DealAnalysis::Opening op{openings[o], {}};
+        for (std::size_t s = 0; s < nSeats; ++s)
+            op.seats.push_back(summarise(tallies[(o + 1) * nSeats + s], samples));
+        res.openings.push_back(op);
+    }
+    return res;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lit une donne écrite avec les noms de CardId ("7C 8C/…")
+std::vector<std::vector<Card>> parse_deal(const std::string& text)
+{
+    std::vector<std::vector<Card>> hands(1);
+    uint64_t seen = SEVEN_OF_DIAMONDS.bit();
+
+    for (std::size_t i = 0; i < text.size(); ) {
+        const char ch = text[i];
+        if (ch == '/') { hands.emplace_back(); ++i; continue; }
+        if (ch == ' ' || ch == ',') { ++i; continue; }
+
+        const char* rank = i + 1 < text.size() ? std::strchr(card_tables::RANK_CHARS, ch) : nullptr;
+        const char* suit = rank ? std::strchr(card_tables::SUIT_CHARS, text[i + 1]) : nullptr;
+        if (!rank || !suit || !*rank || !*suit)
+            throw std::invalid_argument("bad card at position " + std::to_string(i) + " of the deal");
+        const CardId c(static_cast<int>(suit - card_tables::SUIT_CHARS),
+                       static_cast<int>(rank - card_tables::RANK_CHARS) + 1);
+        if (c == SEVEN_OF_DIAMONDS)
+            throw std::invalid_argument("the 7D opens the round and belongs to no hand");
+        if (seen & c.bit())
+            throw std::invalid_argument(std::string("card ") + c.name() + " appears twice in the deal");
+        seen |= c.bit();
+        hands.back().push_back(c.toCard());
+        i += 2;
+    }
+
+    // Les mains et le 7♦ doivent former exactement le jeu complet
+    if (const uint64_t missing = card_masks::ALL & ~seen) {
+        std::string names;
+        for (uint64_t m = missing; m; m &= m - 1) {
+            if (!names.empty()) names += ' ';
+            names += CardId(static_cast<uint8_t>(__builtin_ctzll(m))).name();
+        }
+        throw std::invalid_argument("the deal does not give out every card, missing: " + names);
+    }
+    return hands;
+}
+
+} // namespace sevens
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+#include "PlayerStrategy.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Monte Carlo analysis of one deal: the round is replayed many times with
+ * the same hands and the same strategies, on every core, and the outcomes
+ * summarised per seat.
+ *
+ * Variation between replays comes from the strategies' own randomness and,
+ * for the per-opening results, from imposing each legal first move of seat
+ * 0 in turn. A round is won by the seat with the fewest cards left (ties
+ * share the win).
+ */
+struct SeatOutcome {
+    double meanLeft  = 0;   // cartes restantes en moyenne
+    double leftError = 0;   // demi-largeur de l'intervalle à 95 %
+    double winProb   = 0;
+    double winLow    = 0;   // intervalle de Wilson à 95 %
+    double winHigh   = 0;
+};
+
+struct DealAnalysis {
+    uint64_t samples = 0;               // replays per line below
+    std::vector<SeatOutcome> seats;     // strategies play freely
+
+    struct Opening {
+        Card card;                      // seat 0's imposed first move
+        std::vector<SeatOutcome> seats;
+    };
+    std::vector<Opening> openings;      // empty if seat 0 has < 2 choices
+};
+
+// New strategy for `seat`; called concurrently from the worker threads
+using StrategyFactory = std::function<std::shared_ptr<PlayerStrategy>(std::size_t seat)>;
+
+DealAnalysis analyze_deal(const std::vector<std::vector<Card>>& hands,
+                          const StrategyFactory& makeStrategy,
+                          uint64_t samples, unsigned threads);
+
+// "7C 8C KH/2D 9S/..." : seats separated by '/', cards by spaces or commas
+// (rank A23456789TJQK then suit CDHS). The hands must hold every card but
+// the 7D exactly once; throws std::invalid_argument naming the card otherwise
+std::vector<std::vector<Card>> parse_deal(const std::string& text);
+
+} // namespace sevens
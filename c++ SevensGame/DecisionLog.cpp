@@ -0,0 +1,145 @@
+#include "DecisionLog.hpp"
+#include "CardId.hpp"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace sevens {
+
+namespace {
+
+constexpr char     MAGIC[4] = {'S', 'V', 'R', 'C'};
+constexpr uint32_t VERSION  = 1;
+
+void put(std::ofstream& out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.put(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Ouvre le journal et écrit l'en-tête (noms des joueurs par siège)
+DecisionRecorder::DecisionRecorder(const std::string& path,
+                                   const std::vector<std::string>& seatNames)
+    : out(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out)
+        throw std::runtime_error("cannot write decision log " + path);
+    out.write(MAGIC, sizeof MAGIC);
+    put(out, VERSION, 4);
+    put(out, seatNames.size(), 1);
+    for (const auto& name : seatNames) {
+        put(out, name.size(), 2);
+        out << name;
+    }
+}
+
+void DecisionRecorder::gameStart()
+{
+    out.put('G');
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Mains distribuées, dans l'ordre des sièges et l'ordre des cartes du moteur
+void DecisionRecorder::roundStart(const std::vector<uint64_t>& ids,
+                                  const std::unordered_map<uint64_t, std::vector<Card>>& hands)
+{
+    out.put('R');
+    for (auto id : ids) {
+        const auto& hand = hands.at(id);
+        put(out, hand.size(), 1);
+        for (const auto& c : hand)
+            put(out, CardId(c).value, 1);
+    }
+}
+
+void DecisionRecorder::move(uint64_t seat, const Card& card)
+{
+    out.put('M');
+    put(out, seat, 1);
+    put(out, CardId(card).value, 1);
+}
+
+void DecisionRecorder::pass(uint64_t seat)
+{
+    out.put('P');
+    put(out, seat, 1);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Relit un journal et le découpe en parties (contrôle de la structure)
+DecisionLog DecisionLog::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("cannot open decision log " + path);
+    const std::string buf((std::istreambuf_iterator<char>(in)),
+                          std::istreambuf_iterator<char>());
+
+    std::size_t pos = 0;
+    auto need = [&](std::size_t n) {
+        if (pos + n > buf.size())
+            throw std::runtime_error("decision log " + path + " is truncated");
+    };
+    auto get = [&](int bytes) {
+        need(bytes);
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i)
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(buf[pos++])) << (8 * i);
+        return v;
+    };
+
+    need(sizeof MAGIC);
+    if (buf.compare(0, sizeof MAGIC, MAGIC, sizeof MAGIC) != 0)
+        throw std::runtime_error(path + " is not a decision log");
+    pos = sizeof MAGIC;
+    if (get(4) != VERSION)
+        throw std::runtime_error("unsupported decision log version in " + path);
+
+    DecisionLog log;
+    const uint64_t nSeats = get(1);
+    for (uint64_t s = 0; s < nSeats; ++s) {
+        const uint64_t len = get(2);
+        need(len);
+        log.seatNames.push_back(buf.substr(pos, len));
+        pos += len;
+    }
+
+    auto bad = [&] { return std::runtime_error("decision log " + path + " is malformed"); };
+    std::size_t gameStart = 0;
+    bool inGame = false;
+    while (pos < buf.size()) {
+        const char tag = buf[pos++];
+        switch (tag) {
+        case 'G':
+            if (inGame) log.games.push_back(buf.substr(gameStart, pos - 1 - gameStart));
+            inGame = true;
+            gameStart = pos;
+            break;
+        case 'R':
+            for (uint64_t s = 0; s < nSeats; ++s) {
+                const uint64_t n = get(1);
+                need(n);
+                for (uint64_t k = 0; k < n; ++k)
+                    if (static_cast<unsigned char>(buf[pos + k]) >= CardId::NUM_CARDS) throw bad();
+                pos += n;
+            }
+            break;
+        case 'M':
+            if (get(1) >= nSeats || get(1) >= CardId::NUM_CARDS) throw bad();
+            break;
+        case 'P':
+            if (get(1) >= nSeats) throw bad();
+            break;
+        default:
+            throw bad();
+        }
+        if (!inGame) throw bad();
+    }
+    if (inGame) log.games.push_back(buf.substr(gameStart));
+    return log;
+}
+
+} // namespace sevens
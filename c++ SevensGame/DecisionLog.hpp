@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Record of every decision taken during a run (competition --record FILE),
+ * replayed by the replay-diff mode.
+ *
+ * Each move or pass the engine applies answers exactly one decision, so the
+ * log holds the dealt hands of every round and the resulting events; the
+ * hand, table and observation history of any decision are rebuilt from it.
+ *
+ * File layout (little-endian):
+ *   "SVRC" | u32 version=1 | u8 nSeats | per seat: u16 nameLen | name
+ *   then a stream of events:
+ *     'G'                                     new game
+ *     'R' | per seat: u8 n | n x u8 CardId    new round, hands in engine order
+ *     'M' | u8 seat | u8 CardId               seat played the card
+ *     'P' | u8 seat                           seat passed
+ */
+class DecisionRecorder {
+public:
+    // Throws std::runtime_error if the file cannot be created
+    DecisionRecorder(const std::string& path, const std::vector<std::string>& seatNames);
+
+    void gameStart();
+    void roundStart(const std::vector<uint64_t>& ids,
+                    const std::unordered_map<uint64_t, std::vector<Card>>& hands);
+    void move(uint64_t seat, const Card& card);
+    void pass(uint64_t seat);
+
+private:
+    std::ofstream out;
+};
+
+/**
+ * A log read back in memory: one byte string of events per game, decoded
+ * lazily by the replayer.
+ */
+struct DecisionLog {
+    std::vector<std::string> seatNames;
+    std::vector<std::string> games;   // events following each 'G'
+
+    // Throws std::runtime_error if the file is missing or malformed
+    static DecisionLog load(const std::string& path);
+};
+
+} // namespace sevens
@@ -0,0 +1,82 @@
+#include "DecisionWatchdog.hpp"
+
+#include <utility>
+
+namespace sevens {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Arrête le thread de travail après la dernière décision
+DecisionWatchdog::~DecisionWatchdog()
+{
+    if (!worker.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Confie une décision au thread de travail et attend au plus jusqu'à deadline
+bool DecisionWatchdog::run_until(std::function<void()> task,
+                                 DecisionClock::time_point deadline)
+{
+    if (!worker.joinable())
+        worker = std::thread(&DecisionWatchdog::loop, this);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this] { return !busy; });
+    pending = std::move(task);
+    busy = true;
+    cv.notify_all();
+    if (!cv.wait_until(lock, deadline, [this] { return !busy; }))
+        return false;
+    rethrowFailure();
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Attend la fin de la décision en cours (stratégie en retard)
+void DecisionWatchdog::wait()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this] { return !busy; });
+    rethrowFailure();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Relance sur le thread du moteur l'exception de la dernière décision (mtx tenu)
+void DecisionWatchdog::rethrowFailure()
+{
+    if (failure)
+        std::rethrow_exception(std::exchange(failure, nullptr));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Boucle du thread de travail
+void DecisionWatchdog::loop()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        cv.wait(lock, [this] { return stopping || (busy && pending); });
+        if (stopping)
+            return;
+        auto task = std::move(pending);
+        pending = nullptr;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {   // une exception hors du thread terminerait le processus
+            error = std::current_exception();
+        }
+        lock.lock();
+        failure = error;
+        busy = false;
+        cv.notify_all();
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace sevens {
+
+/**
+ * Runs strategy decisions on a dedicated worker thread so the engine can
+ * stop waiting at the deadline.
+ *
+ * A strategy is not thread-safe, so after a timeout the engine still calls
+ * wait() before notifying anyone of the forced move: the deadline decides
+ * which answer is played, while a strategy that ignores it only delays the
+ * game. The worker is started on first use and reused for every decision.
+ */
+class DecisionWatchdog {
+public:
+    DecisionWatchdog() = default;
+    ~DecisionWatchdog();
+
+    DecisionWatchdog(const DecisionWatchdog&) = delete;
+    DecisionWatchdog& operator=(const DecisionWatchdog&) = delete;
+
+    // Starts task on the worker; true if it finished before deadline. An
+    // exception thrown by the task is rethrown here, or by wait() if the
+    // deadline passed first
+    bool run_until(std::function<void()> task, DecisionClock::time_point deadline);
+
+    // Blocks until the last task has returned
+    void wait();
+
+private:
+    void loop();
+    void rethrowFailure();
+
+    std::thread             worker;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::function<void()>   pending;
+    std::exception_ptr      failure;    // exception de la dernière tâche
+    bool                    busy = false;
+    bool                    stopping = false;
+};
+
+} // namespace sevens
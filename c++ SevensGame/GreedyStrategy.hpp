@@ -6,18 +6,27 @@ namespace sevens {
 
 /**
  * A (placeholder) greedy strategy skeleton.
+ *
+ * final and defined inline, like RandomStrategy, for StaticGameEngine.
  */
-class GreedyStrategy : public PlayerStrategy {
+class GreedyStrategy final : public PlayerStrategy {
 public:
     GreedyStrategy() = default;
     ~GreedyStrategy() override = default;
     
-    void initialize(uint64_t playerID) override;
+    void initialize(uint64_t playerID) override { myID = playerID; }
     int selectCardToPlay(
         const std::vector<Card>& hand,
-        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
-    void observeMove(uint64_t playerID, const Card& playedCard) override;
-    void observePass(uint64_t playerID) override;
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        (void)tableLayout;  // suppress unused-parameter warning
+        if (hand.empty()) {
+            return -1; // pass
+        }
+        return 0; // Always choose the first card in the hand
+    }
+    void observeMove(uint64_t /*playerID*/, const Card& /*playedCard*/) override {}
+    void observePass(uint64_t /*playerID*/) override {}
     std::string getName() const override;
     
 private:
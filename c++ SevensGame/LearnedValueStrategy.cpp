@@ -0,0 +1,250 @@
+#include "PlayerStrategy.hpp"
+#include "SevensFeatures.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Value-function strategy: every legal card is described by a small feature
+ * vector and scored by a linear model or a one-hidden-layer MLP; the best
+ * score is played.
+ *
+ * All candidates of a decision are evaluated together: features are stored
+ * transposed, one 16-float vector per feature with one lane per candidate,
+ * so the whole batch is a single (hidden x features) x (features x 16)
+ * product written with GCC/Clang vector extensions (SSE/AVX on x86, NEON on
+ * ARM; build with -march=native to get the widest registers).
+ *
+ * Weights file (little-endian), loaded by createStrategy() from
+ * $SEVENS_WEIGHTS or ./learned_weights.bin:
+ *   "SVNN" | u32 version=1 | u32 nFeatures=16 | u32 nHidden (0 = linear)
+ *   linear : f32 w[nFeatures] | f32 b
+ *   mlp    : f32 W1[nHidden][nFeatures] | f32 b1[nHidden] | f32 w2[nHidden] | f32 b2
+ * Without a file, built-in linear weights are used.
+ */
+class LearnedValueStrategy : public PlayerStrategy {
+public:
+    static constexpr int NUM_FEATURES = 16;
+    static constexpr int MAX_HIDDEN   = 64;
+    static constexpr int BATCH        = 16;   // >= 13 cartes en main, multiple de 4/8
+
+    // Un registre vectoriel logique : une voie par carte candidate
+    typedef float Lane __attribute__((vector_size(BATCH * sizeof(float))));
+
+    struct Model {
+        int nHidden = 0;
+        alignas(64) float w1[MAX_HIDDEN][NUM_FEATURES] = {};   // ou w1[0] en linéaire
+        alignas(64) float b1[MAX_HIDDEN] = {};
+        alignas(64) float w2[MAX_HIDDEN] = {};
+        float b2 = 0.0f;
+    };
+
+    explicit LearnedValueStrategy(const Model& model) : model_(model) { }
+    ~LearnedValueStrategy() override = default;
+
+    void initialize(uint64_t id) override {
+        features_.reset(id);
+    }
+
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table
+    ) override {
+        // 1) Main et table en masques (incrémentaux, reconstruits à chaque donne)
+        features_.sync(hand, table);
+
+        // 2) Candidats légaux
+        int candidates[BATCH];
+        int nCand = 0;
+        for (int i = 0; i < static_cast<int>(hand.size()) && nCand < BATCH; ++i)
+            if (features_.playable(hand[i].suit) & bit(hand[i].rank))
+                candidates[nCand++] = i;
+        if (nCand == 0) return -1;
+
+        // 3) Matrice de features transposée [feature][candidat]
+        Lane x[NUM_FEATURES] = {};
+        for (int k = 0; k < nCand; ++k)
+            extractFeatures(hand[candidates[k]], x, k);
+
+        // 4) Inférence groupée et choix du meilleur score
+        Lane out;
+        infer(x, out);
+
+        int best = 0;
+        for (int k = 1; k < nCand; ++k)
+            if (out[k] > out[best]) best = k;
+        return candidates[best];
+    }
+
+    void observeMove(uint64_t playerID, const Card& card) override {
+        features_.observeMove(playerID, card);
+    }
+
+    void observePass(uint64_t playerID) override {
+        features_.observePass(playerID);
+    }
+
+    std::string getName() const override {
+        return model_.nHidden ? "LearnedMLP" : "LearnedLinear";
+    }
+
+    // Lit un fichier de poids ; renvoie false si absent ou invalide
+    static bool loadModel(const std::string& path, Model& m, std::string& error) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) { error = "cannot open " + path; return false; }
+
+        char magic[4];
+        uint32_t header[3];
+        if (!in.read(magic, 4) || std::memcmp(magic, "SVNN", 4) != 0 ||
+            !in.read(reinterpret_cast<char*>(header), sizeof header)) {
+            error = path + " is not a weights file";
+            return false;
+        }
+        if (header[0] != 1 || header[1] != NUM_FEATURES || header[2] > MAX_HIDDEN) {
+            error = path + ": unsupported version or shape";
+            return false;
+        }
+
+        m = Model{};
+        m.nHidden = static_cast<int>(header[2]);
+        auto readFloats = [&](float* dst, std::size_t n) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(dst), n * sizeof(float)));
+        };
+        bool ok;
+        if (m.nHidden == 0) {
+            ok = readFloats(m.w1[0], NUM_FEATURES) && readFloats(&m.b2, 1);
+        } else {
+            ok = true;
+            for (int h = 0; ok && h < m.nHidden; ++h)
+                ok = readFloats(m.w1[h], NUM_FEATURES);
+            ok = ok && readFloats(m.b1, m.nHidden) && readFloats(m.w2, m.nHidden)
+                    && readFloats(&m.b2, 1);
+        }
+        if (!ok) error = path + " is truncated";
+        return ok;
+    }
+
+    // Poids linéaires par défaut, réglés à la main (proches de SmartSevens)
+    static Model defaultModel() {
+        static const float w[NUM_FEATURES] = {
+            0.0f,   // biais
+           -1.0f,   // ouvre une couleur (7)
+            0.5f,   // distance au 7
+            2.0f,   // cartes de la couleur en main
+            6.0f,   // cartes à moi débloquées
+           -3.0f,   // cartes adverses débloquées
+            4.0f,   // cartes à moi au-delà dans la même direction
+           -2.0f,   // cartes inconnues au-delà
+            0.0f,   // taille de la main
+            0.0f,   // nombre de coups jouables
+            0.0f,   // remplissage de la table
+            0.0f,   // passes adverses
+           -1.0f,   // cartes inconnues de la couleur
+           -1.0f,   // carte isolée
+            0.5f,   // couleur déjà ouverte
+            1.0f,   // cartes à moi de l'autre côté du 7
+        };
+        Model m;
+        std::memcpy(m.w1[0], w, sizeof w);
+        return m;
+    }
+
+private:
+    static constexpr uint16_t FULL_SUIT = GameFeatures::FULL_SUIT;
+
+    static constexpr uint16_t bit(int rank) { return GameFeatures::bit(rank); }
+    static constexpr uint16_t playableMask(uint16_t placed) { return GameFeatures::playableMask(placed); }
+    static float count(uint32_t mask) { return static_cast<float>(GameFeatures::count(mask)); }
+
+    void extractFeatures(const Card& card, Lane (&x)[NUM_FEATURES], int k) const
+    {
+        const int s = card.suit, r = card.rank;
+        const uint16_t b       = bit(r);
+        const uint16_t mine    = features_.hand(s);
+        const uint16_t placed  = features_.table(s);
+        const uint16_t after   = placed | b;
+        const uint16_t unknown = static_cast<uint16_t>(FULL_SUIT & ~mine & ~placed);
+
+        // Rangs situés au-delà de la carte (en s'éloignant du 7), puis de l'autre côté
+        const uint16_t below = static_cast<uint16_t>(b - 1);
+        const uint16_t above = static_cast<uint16_t>(FULL_SUIT & ~(b | below));
+        const uint16_t beyond = r < 7 ? below : (r > 7 ? above : 0);
+        const uint16_t low7   = static_cast<uint16_t>(bit(7) - 1);
+        const uint16_t high7  = static_cast<uint16_t>(FULL_SUIT & ~(low7 | bit(7)));
+        const uint16_t other  = r < 7 ? high7 : (r > 7 ? low7 : 0);
+
+        const uint16_t newlyPlayable = playableMask(after) & ~playableMask(placed);
+        const uint16_t neighbours    = static_cast<uint16_t>(((b << 1) | (b >> 1)) & FULL_SUIT);
+
+        const uint64_t opp  = features_.opponentPasses();
+        const float passes  = opp < 30 ? static_cast<float>(opp) : 30.0f;
+
+        x[0][k]  = 1.0f;
+        x[1][k]  = r == 7 ? 1.0f : 0.0f;
+        x[2][k]  = static_cast<float>(r > 7 ? r - 7 : 7 - r) / 6.0f;
+        x[3][k]  = count(mine) / 13.0f;
+        x[4][k]  = count(newlyPlayable & mine) / 2.0f;
+        x[5][k]  = count(newlyPlayable & unknown & neighbours) / 2.0f;
+        x[6][k]  = count(beyond & mine) / 6.0f;
+        x[7][k]  = count(beyond & unknown) / 6.0f;
+        x[8][k]  = static_cast<float>(features_.handSize()) / 13.0f;
+        x[9][k]  = static_cast<float>(features_.playableCount()) / 13.0f;
+        x[10][k] = static_cast<float>(features_.tableCount()) / 52.0f;
+        x[11][k] = passes / 30.0f;
+        x[12][k] = count(unknown) / 12.0f;
+        x[13][k] = (neighbours & mine) ? 0.0f : 1.0f;
+        x[14][k] = placed ? 1.0f : 0.0f;
+        x[15][k] = count(other & mine) / 6.0f;
+    }
+
+    // Score de chaque voie : modèle(x[.][c]) pour les BATCH candidats à la fois
+    void infer(const Lane (&x)[NUM_FEATURES], Lane& out) const {
+        out = Lane{} + model_.b2;
+        if (model_.nHidden == 0) {
+            for (int f = 0; f < NUM_FEATURES; ++f)
+                out += model_.w1[0][f] * x[f];
+            return;
+        }
+
+        for (int h = 0; h < model_.nHidden; ++h) {
+            Lane acc = Lane{} + model_.b1[h];
+            for (int f = 0; f < NUM_FEATURES; ++f)
+                acc += model_.w1[h][f] * x[f];
+            const Lane relu = acc > 0.0f ? acc : Lane{};
+            out += model_.w2[h] * relu;
+        }
+    }
+
+    GameFeatures features_;
+    Model        model_;
+};
+
+} // namespace sevens
+
+// Création dynamique de la stratégie (si build en .so)
+#ifdef BUILD_SHARED_LIB
+extern "C" sevens::PlayerStrategy* createStrategy() {
+    using sevens::LearnedValueStrategy;
+
+    const char* env = std::getenv("SEVENS_WEIGHTS");
+    const std::string path = env ? env : "learned_weights.bin";
+
+    LearnedValueStrategy::Model model;
+    std::string error;
+    if (!LearnedValueStrategy::loadModel(path, model, error)) {
+        if (env) {   // fichier demandé explicitement : erreur fatale
+            std::cerr << "LearnedValueStrategy: " << error << '\n';
+            return nullptr;
+        }
+        model = LearnedValueStrategy::defaultModel();
+    }
+    return new LearnedValueStrategy(model);
+}
+#endif
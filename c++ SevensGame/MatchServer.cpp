@@ -0,0 +1,361 @@
+#include "MatchServer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+constexpr char     MAGIC[4] = {'S', 'V', 'M', 'Q'};
+constexpr uint32_t VERSION  = 1;
+constexpr int      MAX_SEATS = 8;
+
+// Self-pipe : le gestionnaire y écrit un octet, la boucle d'acceptation
+// l'attend avec poll() en même temps que le socket, sans fenêtre perdue
+int stopPipe[2] = {-1, -1};
+
+void onStopSignal(int)
+{
+    const int saved = errno;
+    const char byte = 1;
+    const ssize_t w = ::write(stopPipe[1], &byte, 1);   // tube plein : déjà signalé
+    (void)w;
+    errno = saved;
+}
+
+// Non bloquant, et fermé à l'exec
+void makeNonBlocking(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+// Écrit un entier non signé en little-endian sur `bytes` octets
+void put(std::string& out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+// Lit exactement n octets ; false si la connexion est fermée
+bool readExact(int fd, char* dst, std::size_t n)
+{
+    while (n > 0) {
+        const ssize_t r = ::recv(fd, dst, n, 0);
+        if (r == 0) return false;
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        dst += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+bool readUint(int fd, uint64_t& v, int bytes)
+{
+    unsigned char buf[8];
+    if (!readExact(fd, reinterpret_cast<char*>(buf), bytes))
+        return false;
+    v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    return true;
+}
+
+// Envoie tout le tampon ; false si le client est parti
+bool sendAll(int fd, const std::string& data)
+{
+    std::size_t done = 0;
+    while (done < data.size()) {
+        const ssize_t w = ::send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        done += static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+// Supprime un socket laissé par une instance arrêtée ; refuse de toucher à
+// un fichier ordinaire ou au socket d'un serveur encore actif
+void removeStaleSocket(const sockaddr_un& addr)
+{
+    const std::string path = addr.sun_path;
+    struct stat st;
+    if (::lstat(path.c_str(), &st) != 0) {
+        if (errno == ENOENT) return;
+        throw std::runtime_error("cannot stat " + path + ": " + std::strerror(errno));
+    }
+    if (!S_ISSOCK(st.st_mode))
+        throw std::runtime_error(path + " exists and is not a socket");
+
+    const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0)
+        throw std::runtime_error("cannot create socket: " + std::string(std::strerror(errno)));
+    const bool alive = ::connect(probe, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) == 0;
+    ::close(probe);
+    if (alive)
+        throw std::runtime_error("another server is already listening on " + path);
+    if (::unlink(path.c_str()) != 0 && errno != ENOENT)
+        throw std::runtime_error("cannot remove stale socket " + path + ": " + std::strerror(errno));
+}
+
+bool sendError(int fd, const std::string& message)
+{
+    const std::string msg = message.substr(0, 0xFFFF);
+    std::string out(1, 'E');
+    put(out, msg.size(), 2);
+    out += msg;
+    return sendAll(fd, out);
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Constructeur : rien n'est ouvert avant run()
+MatchServer::MatchServer(std::string path, unsigned workers_,
+                         MyGameMapper::TimeControl tc)
+    : socketPath(std::move(path)), nWorkers(std::max(1u, workers_)), timeControl(tc)
+{ }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Arrête les workers et supprime le socket
+MatchServer::~MatchServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        for (int fd : active)
+            ::shutdown(fd, SHUT_RDWR);   // débloque les workers en lecture
+    }
+    cv.notify_all();
+    for (auto& w : workers)
+        w.join();
+    for (int fd : pending)
+        ::close(fd);
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Boucle d'acceptation : chaque connexion est confiée à un worker
+void MatchServer::run()
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof addr.sun_path)
+        throw std::runtime_error("invalid socket path " + socketPath);
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    removeStaleSocket(addr);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error("cannot create socket: " + std::string(std::strerror(errno)));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+        const int err = errno;
+        ::close(fd);
+        throw std::runtime_error("cannot bind " + socketPath + ": " + std::strerror(err));
+    }
+    listenFd = fd;   // le socket est à nous : le destructeur le supprimera
+
+    // Les clients font charger des bibliothèques au serveur : propriétaire seulement
+    if (::chmod(socketPath.c_str(), 0600) != 0 || ::listen(listenFd, 64) != 0)
+        throw std::runtime_error("cannot listen on " + socketPath + ": " + std::strerror(errno));
+
+    if (stopPipe[0] < 0) {
+        if (::pipe(stopPipe) != 0)
+            throw std::runtime_error("cannot create pipe: " + std::string(std::strerror(errno)));
+        makeNonBlocking(stopPipe[0]);
+        makeNonBlocking(stopPipe[1]);
+    }
+    char drain[64];
+    while (::read(stopPipe[0], drain, sizeof drain) > 0) { }   // signaux d'un run() précédent
+    makeNonBlocking(listenFd);   // poll() décide, accept() ne bloque pas
+
+    struct sigaction sa{};
+    sa.sa_handler = onStopSignal;
+    sigemptyset(&sa.sa_mask);
+    ::sigaction(SIGINT, &sa, nullptr);
+    ::sigaction(SIGTERM, &sa, nullptr);
+
+    // Les workers (et leurs threads) masquent ces signaux : seul ce thread les reçoit
+    sigset_t stopSignals, previous;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &stopSignals, &previous);
+    for (unsigned i = 0; i < nWorkers; ++i)
+        workers.emplace_back(&MatchServer::worker, this);
+    ::pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+    std::cout << "[serve] Listening on " << socketPath << " with "
+              << nWorkers << " workers\n" << std::flush;
+
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+    while (true) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("poll failed: " + std::string(std::strerror(errno)));
+        }
+        if (fds[1].revents)
+            break;
+        const int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            throw std::runtime_error("accept failed: " + std::string(std::strerror(errno)));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            pending.push_back(fd);
+        }
+        cv.notify_one();
+    }
+    std::cout << "[serve] Shutting down\n";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Worker : un moteur prêt à l'emploi, réutilisé pour chaque connexion
+void MatchServer::worker()
+{
+    MyGameMapper mapper;
+    mapper.setTimeControl(timeControl);
+    mapper.read_cards("");
+    mapper.read_game("");
+
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping)
+                return;
+            fd = pending.front();
+            pending.pop_front();
+            active.insert(fd);
+        }
+        try {
+            serve(fd, mapper);
+        } catch (const std::exception& e) {   // hors match (allocation…) : seule la connexion tombe
+            std::cerr << "[serve] connection dropped: " << e.what() << "\n";
+        }
+        mapper.clearStrategies();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            active.erase(fd);
+        }
+        ::close(fd);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Traite les requêtes d'une connexion jusqu'à sa fermeture
+void MatchServer::serve(int fd, MyGameMapper& mapper)
+{
+    while (true) {
+        char magic[sizeof MAGIC];
+        if (!readExact(fd, magic, sizeof magic))
+            return;   // fin normale : le client a fermé
+        uint64_t version, seed, games, nSeats;
+        if (std::memcmp(magic, MAGIC, sizeof MAGIC) != 0 ||
+            !readUint(fd, version, 4) || version != VERSION ||
+            !readUint(fd, seed, 8) || !readUint(fd, games, 8) || !readUint(fd, nSeats, 1)) {
+            sendError(fd, "malformed request header");
+            return;
+        }
+
+        std::vector<std::string> paths(nSeats);
+        for (auto& path : paths) {
+            uint64_t len;
+            if (!readUint(fd, len, 2)) return;
+            path.resize(len);
+            if (len && !readExact(fd, &path[0], len)) return;
+        }
+        if (nSeats < 2 || nSeats > MAX_SEATS) {
+            if (!sendError(fd, "a match needs 2 to 8 plugins")) return;
+            continue;
+        }
+
+        // Une exception d'un plugin ou du moteur ne concerne que cette requête :
+        // elle devient une réponse 'E' et la connexion reste utilisable
+        std::string done;
+        try {
+            done = play_match(fd, mapper, paths, seed, games);
+        } catch (const std::exception& e) {
+            if (!sendError(fd, e.what())) return;
+            continue;
+        } catch (...) {
+            if (!sendError(fd, "unknown error during the match")) return;
+            continue;
+        }
+        if (done.empty())
+            return;   // client parti : on abandonne le match
+        if (!sendAll(fd, done))
+            return;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Joue un match en envoyant un 'G' par partie ; rend la réponse 'D' finale,
+// vide si le client est parti
+std::string MatchServer::play_match(int fd, MyGameMapper& mapper,
+                                    const std::vector<std::string>& paths,
+                                    uint64_t seed, uint64_t games)
+{
+    const uint64_t nSeats = paths.size();
+
+    // Nouvelles instances à chaque match, bibliothèques déjà chargées
+    mapper.clearStrategies();
+    for (std::size_t i = 0; i < paths.size(); ++i)
+        mapper.registerStrategy(i, plugins.create(paths[i]));
+
+    std::vector<uint64_t> wins(nSeats, 0), points(nSeats, 0);
+    for (uint64_t g = 0; g < games; ++g) {
+        mapper.reseed(seed, g);
+        auto res = mapper.compute_game_progress(nSeats);
+
+        uint64_t best = UINT64_MAX;
+        for (auto& p : res)
+            best = std::min(best, p.second);
+
+        std::string out(1, 'G');
+        put(out, g, 8);
+        put(out, nSeats, 1);
+        for (auto& p : res) {
+            points[p.first] += p.second;
+            if (p.second == best) ++wins[p.first];
+            put(out, p.second, 4);
+        }
+        if (!sendAll(fd, out))
+            return {};
+    }
+
+    std::string done(1, 'D');
+    put(done, games, 8);
+    put(done, nSeats, 1);
+    for (uint64_t i = 0; i < nSeats; ++i) {
+        put(done, wins[i], 8);
+        put(done, points[i], 8);
+    }
+    return done;
+}
+
+} // namespace sevens
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "MyGameMapper.hpp"
+#include "StrategyLoader.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Long-running match server ("sevens_game serve") on a Unix domain socket.
+ *
+ * Plugins stay loaded (PluginCache) and every worker thread keeps its own
+ * engine, so a request only pays for the games it asks for. Each connection
+ * is served by one worker and may send any number of requests in turn;
+ * connections beyond the number of workers wait in a queue.
+ *
+ * Protocol (little-endian, integers unsigned):
+ *   request : "SVMQ" | u32 version=1 | u64 seed | u64 games | u8 nPlugins (2..8)
+ *             then per seat: u16 pathLen | path bytes
+ *   replies : 'G' | u64 game index | u8 n | n x u32 points      one per game, streamed
+ *             'D' | u64 games | u8 n | n x (u64 wins | u64 points)   end of the match
+ *             'E' | u16 len | message     request refused or match aborted (a
+ *                                         plugin or the engine threw, possibly
+ *                                         after some 'G'); after a malformed
+ *                                         header the connection is closed
+ * Game #i of a request is dealt from (seed, i), as in a --seed series.
+ */
+class MatchServer {
+public:
+    MatchServer(std::string socketPath, unsigned workers,
+                MyGameMapper::TimeControl timeControl = {});
+    ~MatchServer();
+
+    MatchServer(const MatchServer&) = delete;
+    MatchServer& operator=(const MatchServer&) = delete;
+
+    // Serves until SIGINT/SIGTERM; throws std::runtime_error if the socket
+    // cannot be opened, or if the path holds a file or a live server's socket.
+    // The socket is created with mode 0600.
+    void run();
+
+private:
+    void worker();
+    void serve(int fd, MyGameMapper& mapper);
+    std::string play_match(int fd, MyGameMapper& mapper, const std::vector<std::string>& paths,
+                           uint64_t seed, uint64_t games);
+
+    std::string               socketPath;
+    unsigned                  nWorkers;
+    MyGameMapper::TimeControl timeControl;
+    PluginCache               plugins;
+
+    std::mutex                mtx;
+    std::condition_variable   cv;
+    std::deque<int>           pending;    // connexions en attente d'un worker
+    std::unordered_set<int>   active;     // connexions en cours de traitement
+    bool                      stopping = false;
+    std::vector<std::thread>  workers;
+    int                       listenFd = -1;
+};
+
+} // namespace sevens
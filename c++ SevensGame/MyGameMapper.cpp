@@ -1,7 +1,12 @@
 #include "MyGameMapper.hpp"
+#include "AllocCounter.hpp"
+#include "CardId.hpp"
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <exception>
 #include <iostream>
+#include <stdexcept>
 
 namespace sevens {
 
@@ -35,78 +40,307 @@ bool MyGameMapper::hasRegisteredStrategies() const {
 void MyGameMapper::registerStrategy(uint64_t playerID,
                                     std::shared_ptr<PlayerStrategy> strat)
 {
+    ponderers.erase(playerID);   // son thread référence la stratégie remplacée
     strategies[playerID] = std::move(strat);
+    strategies[playerID]->attachScratch(scratch.resource());
     strategies[playerID]->initialize(playerID);
     score_board[playerID] = 0;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Simule le jeu jusqu'à ce qu'un joueur dépasse ou atteigne 50 points
-std::vector<std::pair<uint64_t, uint64_t>>
-MyGameMapper::compute_game_progress(uint64_t /*numPlayers*/) {
-    // Liste des identifiants de joueurs
+// Retire tous les joueurs (le moteur peut resservir pour un autre match)
+void MyGameMapper::clearStrategies()
+{
+    ponderers.clear();   // arrête les réflexions avant de détruire les stratégies
+    strategies.clear();
+    score_board.clear();
+    alloc_stats.clear();
+    time_bank.clear();
+    timeouts.clear();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Active le comptage des allocations par décision
+void MyGameMapper::setCountAllocations(bool on)
+{
+    count_allocs = on;
+    alloc_counter::enable(on);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Réensemence le générateur pour la partie n°gameIndex d'une série
+void MyGameMapper::reseed(uint64_t seed, uint64_t gameIndex)
+{
+    rng = seeded_rng(seed, gameIndex);
+}
+
+// Générateur de la partie n°gameIndex (partagé avec les outils : perft, …)
+std::mt19937 MyGameMapper::seeded_rng(uint64_t seed, uint64_t gameIndex)
+{
+    std::seed_seq seq{
+        static_cast<uint32_t>(seed),      static_cast<uint32_t>(seed >> 32),
+        static_cast<uint32_t>(gameIndex), static_cast<uint32_t>(gameIndex >> 32)};
+    return std::mt19937(seq);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Demande un coup à un joueur, sous contrôle du temps si configuré
+int MyGameMapper::decide(uint64_t id, const std::vector<Card>& hand,
+                         const TableLayout& table)
+{
+    auto& strat = strategies.at(id);
+    DecisionSlot slot;
+    if (auto it = ponderers.find(id); it != ponderers.end())
+        it->second->stop();
+
+    auto call = [&](DecisionClock::time_point deadline) {
+        if (!count_allocs)
+            return strat->selectCardToPlay(hand, table, deadline, slot);
+        const auto before = alloc_counter::thisThread();
+        const int idx = strat->selectCardToPlay(hand, table, deadline, slot);
+        const auto after = alloc_counter::thisThread();
+        auto& st = alloc_stats[id];
+        ++st.decisions;
+        st.allocations += after.allocations - before.allocations;
+        st.bytes       += after.bytes - before.bytes;
+        return idx;
+    };
+
+    if (time_control.mode == TimeControl::NONE)
+        return call(DecisionClock::time_point::max());
+
+    // Budget du coup : fixe, ou ce qui reste dans la banque de la partie
+    auto& bank = time_bank[id];
+    const auto budget = time_control.mode == TimeControl::PER_MOVE
+                      ? time_control.budget : bank;
+    if (budget.count() <= 0) {
+        ++timeouts[id];
+        return -1;   // banque épuisée : passe d'office
+    }
+
+    const auto start    = DecisionClock::now();
+    const auto deadline = start + budget;
+    int answer = -1;
+    int idx;
+    if (watchdog.run_until([&] { answer = call(deadline); }, deadline)) {
+        idx = answer;
+    } else {
+        // Délai dépassé : on joue la dernière réponse publiée (ou on passe),
+        // puis on attend que la stratégie rende la main
+        ++timeouts[id];
+        idx = slot.latest();
+        watchdog.wait();
+    }
+
+    if (time_control.mode == TimeControl::GAME_BANK) {
+        bank -= std::chrono::duration_cast<std::chrono::microseconds>(DecisionClock::now() - start);
+        if (bank.count() < 0) bank = std::chrono::microseconds{0};
+    }
+    return idx;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Nouvelle partie : scores, banques de temps et stratégies à zéro ; renvoie
+// les identifiants dans l'ordre de jeu (ordre des sièges)
+std::vector<uint64_t> MyGameMapper::start_game()
+{
     std::vector<uint64_t> ids;
     for (auto& kv : strategies)
         ids.push_back(kv.first);
+    std::sort(ids.begin(), ids.end());
+
+    stop_pondering();
+    for (auto id : ids) {
+        if (pondering && !ponderers.count(id) && strategies.at(id)->wantsPonder())
+            ponderers[id] = std::make_unique<PonderWorker>(*strategies.at(id));
+        score_board[id] = 0;
+        time_bank[id] = time_control.budget;
+        strategies.at(id)->initialize(id);
+    }
+    if (recorder)
+        recorder->gameStart();
+    return ids;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Joue une manche à partir des mains distribuées, jusqu'à blocage
+void MyGameMapper::play_round(const std::vector<uint64_t>& ids,
+                              std::unordered_map<uint64_t, std::vector<Card>>& hands,
+                              std::optional<Card> opening)
+{
+    // Nouvelle donne : la mémoire de travail des stratégies repart de zéro
+    stop_pondering();
+    scratch.reset();
+    if (recorder)
+        recorder->roundStart(ids, hands);
+
+    // Réinitialisation de la table avec uniquement le 7♦
+    game_parser.read_game("");
+    auto table_layout = game_parser.get_table_layout(); // copie modifiable
+    uint64_t table_mask = SEVEN_OF_DIAMONDS.bit();      // état public pour la réflexion
+    uint32_t events = 0;
+
+    // Tour par tour jusqu'à ce qu'aucun joueur ne puisse jouer
+    bool anyMove = true;
+    while (anyMove) {
+        anyMove = false;
+        for (auto id : ids) {
+            // Ouverture imposée (analyse) : premier coup du premier siège
+            int idx;
+            if (opening) {
+                auto& h = hands[id];
+                const CardId wanted(*opening);
+                idx = static_cast<int>(std::find_if(h.begin(), h.end(),
+                          [&](const Card& c) { return CardId(c) == wanted; }) - h.begin());
+                opening.reset();
+            } else {
+                idx = decide(id, hands[id], table_layout);
+            }
+            bool moved = false;
+            int played = -1;
+
+            // Vérifie si l'index proposé est valide
+            if (idx >= 0 && static_cast<size_t>(idx) < hands[id].size()) {
+                Card c = hands[id][idx];
+                // Teste la validité du coup (adjacent à une carte posée)
+                bool playable = (c.rank == 7)
+                    || table_layout[c.suit][c.rank - 1]
+                    || table_layout[c.suit][c.rank + 1];
+                if (playable) {
+                    table_layout[c.suit][c.rank] = true;
+                    table_mask |= CardId(c).bit();
+                    played = CardId(c).value;
+                    hands[id].erase(hands[id].begin() + idx);
+                    if (recorder)
+                        recorder->move(id, c);
+                    // Tous les joueurs observent le coup
+                    stop_pondering();
+                    for (auto& kv : strategies)
+                        kv.second->observeMove(id, c);
+                    moved = true;
+                    anyMove = true;
+                }
+            }
+
+            // Si le joueur n’a pas joué, on le marque en “pass”
+            if (!moved) {
+                if (recorder)
+                    recorder->pass(id);
+                stop_pondering();
+                for (auto& kv : strategies)
+                    kv.second->observePass(id);
+            }
+
+            // Les autres réfléchissent pendant que le suivant décide
+            if (!ponderers.empty())
+                start_pondering(ids, hands, table_mask, ++events, id, played);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Une manche isolée sur une donne fixée (outil d'analyse)
+std::vector<uint64_t> MyGameMapper::play_deal(const std::vector<std::vector<Card>>& dealt,
+                                              std::optional<Card> opening)
+{
+    const std::vector<uint64_t> ids = start_game();
+    if (dealt.size() != ids.size())
+        throw std::invalid_argument("play_deal: one hand per registered player expected");
+
+    std::unordered_map<uint64_t, std::vector<Card>> hands;
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        hands[ids[i]] = dealt[i];
+    play_round(ids, hands, opening);
+    stop_pondering();
+
+    std::vector<uint64_t> left;
+    for (auto id : ids)
+        left.push_back(hands[id].size());
+    return left;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Active la réflexion en arrière-plan des stratégies qui la demandent
+void MyGameMapper::setPondering(bool on)
+{
+    pondering = on;
+    if (!on)
+        ponderers.clear();
+}
+
+uint64_t MyGameMapper::ponder_runs(uint64_t id) const
+{
+    auto it = ponderers.find(id);
+    return it == ponderers.end() ? 0 : it->second->runs();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Interrompt toutes les réflexions (avant d'appeler une stratégie) ; une
+// exception de ponder() n'est relancée qu'une fois tous les threads arrêtés
+void MyGameMapper::stop_pondering()
+{
+    std::exception_ptr failure;
+    for (auto& kv : ponderers) {
+        try {
+            kv.second->stop();
+        } catch (...) {
+            if (!failure) failure = std::current_exception();
+        }
+    }
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Publie l'état après un événement et relance la réflexion des autres joueurs
+void MyGameMapper::start_pondering(const std::vector<uint64_t>& ids,
+                                   const std::unordered_map<uint64_t, std::vector<Card>>& hands,
+                                   uint64_t table, uint32_t events, uint64_t actor, int card)
+{
+    auto state = std::make_shared<PublicState>();
+    state->table      = table;
+    state->events     = events;
+    state->numPlayers = static_cast<int>(std::min<std::size_t>(ids.size(), PublicState::MAX_PLAYERS));
+    for (int i = 0; i < state->numPlayers; ++i) {
+        state->seat[i]     = ids[i];
+        state->handSize[i] = static_cast<uint8_t>(hands.at(ids[i]).size());
+        if (ids[i] == actor) {
+            state->lastSeat = i;
+            state->toMove   = (i + 1) % state->numPlayers;
+        }
+    }
+    state->lastCard = card;
+
+    // Le joueur suivant va décider tout de suite : inutile de le faire réfléchir
+    const PublicSnapshot snapshot = std::move(state);
+    const uint64_t next = snapshot->seat[snapshot->toMove];
+    for (auto& kv : ponderers)
+        if (kv.first != next)
+            kv.second->start(snapshot);
+}
 
-    // Création du paquet de 52 cartes
-    std::vector<Card> deck;
-    deck.reserve(card_parser.get_cards_hashmap().size());
-    for (auto& kv : card_parser.get_cards_hashmap())
-        deck.push_back(kv.second);
+// ─────────────────────────────────────────────────────────────────────────────
+// Simule le jeu jusqu'à ce qu'un joueur dépasse ou atteigne 50 points
+std::vector<std::pair<uint64_t, uint64_t>>
+MyGameMapper::compute_game_progress(uint64_t /*numPlayers*/) {
+    // Liste des identifiants de joueurs, dans l'ordre de jeu
+    const std::vector<uint64_t> ids = start_game();
+
+    // Paquet de 52 identifiants d'un octet, copié depuis le catalogue constexpr
+    std::array<CardId, CardId::NUM_CARDS> deck = FULL_DECK;
 
     // Simulation de manches successives
     while (true) {
         // Mélange et distribution des cartes
         std::shuffle(deck.begin(), deck.end(), rng);
+        // Le 7♦ n'est distribué à personne : il est déjà posé sur la table
         std::unordered_map<uint64_t, std::vector<Card>> hands;
         for (auto id : ids) hands[id] = {};
         for (size_t i = 0; i < deck.size(); ++i)
-            hands[ids[i % ids.size()]].push_back(deck[i]);
-
-        // Réinitialisation de la table avec uniquement le 7♦
-        game_parser.read_game("");
-        auto table_layout = game_parser.get_table_layout(); // copie modifiable
-
-        // Suppression du 7♦ dans chaque main (déjà posé sur la table)
-        for (auto& kv : hands) {
-            auto& h = kv.second;
-            h.erase(std::remove_if(h.begin(), h.end(), [](const Card& c){
-                return c.suit == 1 && c.rank == 7;
-            }), h.end());
-        }
+            if (deck[i] != SEVEN_OF_DIAMONDS)
+                hands[ids[i % ids.size()]].push_back(deck[i].toCard());
 
-        // Tour par tour jusqu'à ce qu'aucun joueur ne puisse jouer
-        bool anyMove = true;
-        while (anyMove) {
-            anyMove = false;
-            for (auto id : ids) {
-                auto& strat = strategies.at(id);
-                int idx = strat->selectCardToPlay(hands[id], table_layout);
-                bool moved = false;
-
-                // Vérifie si l'index proposé est valide
-                if (idx >= 0 && static_cast<size_t>(idx) < hands[id].size()) {
-                    Card c = hands[id][idx];
-                    // Teste la validité du coup (adjacent à une carte posée)
-                    bool playable = (c.rank == 7)
-                        || table_layout[c.suit][c.rank - 1]
-                        || table_layout[c.suit][c.rank + 1];
-                    if (playable) {
-                        table_layout[c.suit][c.rank] = true;
-                        hands[id].erase(hands[id].begin() + idx);
-                        strat->observeMove(id, c);
-                        moved = true;
-                        anyMove = true;
-                    }
-                }
-
-                // Si le joueur n’a pas joué, on le marque en “pass”
-                if (!moved) {
-                    strat->observePass(id);
-                }
-            }
-        }
+        play_round(ids, hands);
 
         // Comptage des cartes restantes → score
         std::vector<std::pair<uint64_t, uint64_t>> results;
@@ -119,6 +353,7 @@ MyGameMapper::compute_game_progress(uint64_t /*numPlayers*/) {
         // Vérifie si un joueur a atteint ou dépassé 50 points
         for (auto& kv : score_board) {
             if (kv.second >= 50) {
+                stop_pondering();
                 return results;
             }
         }
@@ -4,8 +4,15 @@
 #include "MyCardParser.hpp"
 #include "MyGameParser.hpp"
 #include "PlayerStrategy.hpp"
+#include "ScratchArena.hpp"
+#include "DecisionWatchdog.hpp"
+#include "DecisionLog.hpp"
+#include "PonderWorker.hpp"
+
+#include <chrono>
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 #include <random>
@@ -22,6 +29,12 @@ public:
     // (these are not in the base, so drop 'override')
     bool hasRegisteredStrategies() const;
     void registerStrategy(uint64_t playerID, std::shared_ptr<PlayerStrategy> strategy);
+    void clearStrategies();
+
+    // Deterministic shuffling for game #gameIndex of a seeded series,
+    // so a resumed run deals exactly the games it would have dealt.
+    void reseed(uint64_t seed, uint64_t gameIndex);
+    static std::mt19937 seeded_rng(uint64_t seed, uint64_t gameIndex);
 
     std::vector<std::pair<uint64_t, uint64_t>>
     compute_game_progress(uint64_t numPlayers) override;
@@ -29,12 +42,79 @@ public:
     std::vector<std::pair<uint64_t, uint64_t>>
     compute_and_display_game(uint64_t numPlayers) override;
 
+    // Plays a single round from a fixed deal, dealt[i] going to the i-th
+    // registered player in seat order, and returns the cards left per seat.
+    // If set, `opening` is played as the first seat's first move instead of
+    // asking its strategy (it must be in its hand and legal).
+    std::vector<uint64_t> play_deal(const std::vector<std::vector<Card>>& dealt,
+                                    std::optional<Card> opening = std::nullopt);
+
+    // Heap allocations made inside selectCardToPlay, per player (opt-in,
+    // see AllocCounter.hpp)
+    struct DecisionAllocs {
+        uint64_t decisions   = 0;
+        uint64_t allocations = 0;
+        uint64_t bytes       = 0;
+    };
+    void setCountAllocations(bool on);
+    const std::unordered_map<uint64_t, DecisionAllocs>& decision_allocs() const {
+        return alloc_stats;
+    }
+
+    // Time control enforced by a watchdog: a fixed budget per move, or a
+    // bank per player and per game from which each decision's time is taken
+    struct TimeControl {
+        enum Mode { NONE, PER_MOVE, GAME_BANK };
+        Mode mode = NONE;
+        std::chrono::microseconds budget{0};
+    };
+    void setTimeControl(const TimeControl& tc) { time_control = tc; }
+
+    // Background thinking: strategies whose wantsPonder() is true get ponder()
+    // calls on their own thread after every event, and are stopped before
+    // any call the engine makes to them. Off by default.
+    void setPondering(bool on);
+    uint64_t ponder_runs(uint64_t id) const;
+
+    // Logs every deal and every move/pass to `r` (nullptr = off); see DecisionLog.hpp
+    void setRecorder(DecisionRecorder* r) { recorder = r; }
+
+    // Decisions cut by the deadline, per player
+    const std::unordered_map<uint64_t, uint64_t>& decision_timeouts() const {
+        return timeouts;
+    }
+
 private:
+    using TableLayout = std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>;
+
+    std::vector<uint64_t> start_game();
+    void play_round(const std::vector<uint64_t>& ids,
+                    std::unordered_map<uint64_t, std::vector<Card>>& hands,
+                    std::optional<Card> opening = std::nullopt);
+
+    void stop_pondering();
+    void start_pondering(const std::vector<uint64_t>& ids,
+                         const std::unordered_map<uint64_t, std::vector<Card>>& hands,
+                         uint64_t table, uint32_t events, uint64_t actor, int card);
+
+    // Demande un coup au joueur id (comptage des allocations, contrôle du temps)
+    int decide(uint64_t id, const std::vector<Card>& hand, const TableLayout& table);
+
     MyCardParser                card_parser;
     MyGameParser                game_parser;
     std::unordered_map<uint64_t, std::shared_ptr<PlayerStrategy>> strategies;
     std::unordered_map<uint64_t, uint64_t> score_board;
     std::mt19937                rng;
+    ScratchArena                scratch;         // remis à zéro à chaque donne
+    bool                        count_allocs = false;
+    std::unordered_map<uint64_t, DecisionAllocs> alloc_stats;
+    TimeControl                 time_control;
+    DecisionWatchdog            watchdog;
+    std::unordered_map<uint64_t, std::chrono::microseconds> time_bank;
+    std::unordered_map<uint64_t, uint64_t> timeouts;
+    DecisionRecorder*           recorder = nullptr;
+    bool                        pondering = false;
+    std::unordered_map<uint64_t, std::unique_ptr<PonderWorker>> ponderers;
 };
 
 } // namespace sevens
@@ -0,0 +1,334 @@
+#pragma once
+
+#include "CardId.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * What one seat can infer about the other seats' hands.
+ *
+ * Cards are bits 0..51 of a uint64_t, bit = CardId value. For every opponent we keep the mask of cards
+ * it may still hold:
+ *   - a played card is removed from every mask;
+ *   - a pass proves the passer holds none of the cards legal at that moment,
+ *     so they are removed from its mask (this is how suit voids appear).
+ *
+ * The engine also accepts voluntary passes (a strategy returning -1 or an
+ * illegal index). If a seat later plays a card its passes had ruled out, its
+ * passes are no longer trusted: its mask is widened back to every unknown
+ * card and further passes by that seat are ignored.
+ *
+ * Seats are those declared with setNumPlayers(), or else those seen moving
+ * or passing. A seat first seen mid-round may hold any unknown card and
+ * takes its share of the estimated hand sizes; nothing is guessed from the
+ * size of the dealt hand, which does not tell 6 seats from 7 or 8.
+ *
+ * sample() deals the unknown cards to the opponents consistently with the
+ * masks and with their hand sizes; it is allocation-free and takes well
+ * under a microsecond, for use thousands of times per decision.
+ *
+ * As with GameFeatures, call sync(hand, table) from selectCardToPlay() to
+ * pick up new deals.
+ */
+class OpponentBeliefs {
+public:
+    using Mask = uint64_t;
+    static constexpr int  MAX_PLAYERS = 8;
+    static constexpr Mask ALL_CARDS   = card_masks::ALL;
+    using Hands = std::array<Mask, MAX_PLAYERS>;
+
+    // ── bitboard helpers ─────────────────────────────────────────────────────
+    static constexpr Mask cardBit(CardId c) { return c.bit(); }
+    static constexpr Mask suitMask(int suit) { return card_masks::suit(suit); }
+    static constexpr Mask legalMask(Mask table) { return card_masks::legal(table); }
+
+    static int count(Mask m) { return __builtin_popcountll(m); }
+
+    // Bit of a seat in the seat masks; 0 for ids past MAX_PLAYERS (ids are
+    // uint64_t, a plain shift by 32 or more would be undefined)
+    static constexpr uint32_t seatBit(uint64_t player) {
+        return player < MAX_PLAYERS ? uint32_t{1} << player : 0;
+    }
+
+    // ── life-cycle ───────────────────────────────────────────────────────────
+    explicit OpponentBeliefs(uint64_t me = 0) { reset(me); }
+
+    // New game for seat `me`; forgets seats seen and trust flags
+    void reset(uint64_t me) {
+        me_ = me;
+        seats_ = 0;
+        forcedPlayers_ = 0;
+        untrusted_ = 0;
+        untrustedSinceSync_ = 0;
+        hand_ = 0;
+        table_ = sevenOfDiamonds();
+        possible_ = {};
+        counts_ = {};
+        pendingMoves_ = 0;
+    }
+
+    // Declares seats 0..n-1 up front instead of learning them as they act
+    void setNumPlayers(int n) { forcedPlayers_ = n; }
+
+    // New round with `hand`; `table` defaults to the opening 7♦
+    void startRound(const std::vector<Card>& hand, Mask table = sevenOfDiamonds()) {
+        hand_  = maskOf(hand);
+        table_ = table;
+        pendingMoves_ = 0;
+
+        for (int p = 0; p < forcedPlayers_ && p < MAX_PLAYERS; ++p)
+            if (static_cast<uint64_t>(p) != me_) seats_ |= seatBit(p);
+
+        // Cartes inconnues réparties au plus juste entre les adversaires
+        const Mask unknown = this->unknown();
+        const int  nOpp    = count(seats_ & ~seatBit(me_));
+        int left = count(unknown);
+        for (int p = 0, k = 0; p < MAX_PLAYERS; ++p) {
+            possible_[p] = 0;
+            counts_[p]   = 0;
+            if (!isOpponent(p)) continue;
+            possible_[p] = unknown;
+            counts_[p]   = left / (nOpp - k);
+            left -= counts_[p];
+            ++k;
+        }
+    }
+
+    // Resynchronise on a new deal; returns true if the state was rebuilt
+    bool sync(const std::vector<Card>& hand,
+              const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table)
+    {
+        const uint32_t untrustedNow = untrustedSinceSync_;
+        untrustedSinceSync_ = 0;
+        if (maskOf(hand) == hand_) {
+            pendingMoves_ = 0;
+            return false;
+        }
+
+        // Les événements vus depuis notre dernier tour ont été appliqués à
+        // l'ancienne donne : on annule les méfiances qu'ils ont causées et on
+        // rejoue les coups de la nouvelle donne (suffixe dont les cartes sont
+        // sur la nouvelle table).
+        untrusted_ &= ~untrustedNow;
+        const Mask newTable = maskOf(table);
+        const auto pending  = pending_;
+        int first = pendingMoves_;
+        while (first > 0 && (newTable & pending[first - 1].card.bit()))
+            --first;
+        const int last = pendingMoves_;
+        startRound(hand, newTable);
+        for (int i = first; i < last; ++i)
+            takeFrom(pending[i].player);
+        return true;
+    }
+
+    // ── observations ─────────────────────────────────────────────────────────
+    void observeMove(uint64_t player, CardId card) {
+        const Mask b = cardBit(card);
+        if (player < MAX_PLAYERS) {
+            addSeat(player);
+            if (pendingMoves_ < MAX_PENDING)
+                pending_[pendingMoves_++] = {static_cast<uint8_t>(player), card};
+        }
+
+        table_ |= b;
+        if (player == me_) {
+            hand_ &= ~b;
+            return;
+        }
+        if (player < MAX_PLAYERS) {
+            if (!(possible_[player] & b) && !(untrusted_ & seatBit(player))) {
+                // Il avait passé en tenant cette carte : on oublie ses passes
+                untrusted_ |= seatBit(player);
+                untrustedSinceSync_ |= seatBit(player);
+                possible_[player] = unknown() | b;
+            }
+            takeFrom(player);
+        }
+        for (auto& m : possible_) m &= ~b;
+    }
+
+    void observePass(uint64_t player) {
+        if (player >= MAX_PLAYERS) return;
+        addSeat(player);
+        if (player == me_ || (untrusted_ & seatBit(player))) return;
+        possible_[player] &= ~legalMask(table_);
+    }
+
+    // ── queries ──────────────────────────────────────────────────────────────
+    Mask hand() const { return hand_; }
+    Mask table() const { return table_; }
+    Mask unknown() const { return ALL_CARDS & ~hand_ & ~table_; }
+    Mask possible(uint64_t player) const { return player < MAX_PLAYERS ? possible_[player] : 0; }
+    int  handSize(uint64_t player) const { return player < MAX_PLAYERS ? counts_[player] : 0; }
+    bool isVoid(uint64_t player, int suit) const { return !(possible(player) & suitMask(suit)); }
+    bool trusted(uint64_t player) const { return player < MAX_PLAYERS && !(untrusted_ & seatBit(player)); }
+
+    bool isOpponent(int p) const { return static_cast<uint64_t>(p) != me_ && (seats_ & seatBit(p)); }
+
+    /**
+     * Deals every unknown card to an opponent: hands[p] & ~possible(p) == 0
+     * and count(hands[p]) == handSize(p) for every opponent p. Cards that
+     * only one opponent can hold go first, the rest are spread at random
+     * weighted by each seat's remaining room. Retries a few times on a dead
+     * end; returns false (with a best-effort deal where hand sizes are only
+     * preferred) when the constraints look inconsistent.
+     *
+     * Hand sizes are exact except that nobody knows who was dealt the 7♦:
+     * the short hand is attributed to the lowest opponent seat.
+     */
+    template <class URNG>
+    bool sample(URNG& rng, Hands& hands) const {
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt)
+            if (trySample(rng, hands, true)) return true;
+        trySample(rng, hands, false);
+        return false;
+    }
+
+private:
+    static constexpr int MAX_PENDING  = 64;
+    static constexpr int MAX_ATTEMPTS = 4;
+
+    struct PendingMove { uint8_t player; CardId card; };
+
+    static constexpr Mask sevenOfDiamonds() { return SEVEN_OF_DIAMONDS.bit(); }
+
+    static Mask maskOf(const std::vector<Card>& hand) {
+        Mask m = 0;
+        for (const auto& c : hand) m |= cardBit(c);
+        return m;
+    }
+
+    static Mask maskOf(const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table) {
+        Mask m = 0;
+        for (const auto& suit : table)
+            if (suit.first < 4)
+                for (const auto& r : suit.second)
+                    if (r.second && r.first >= 1 && r.first <= 13)
+                        m |= CardId(static_cast<int>(suit.first), static_cast<int>(r.first)).bit();
+        return m;
+    }
+
+    // Siège vu pour la première fois en cours de manche : il peut tenir toute
+    // carte inconnue et prend sa part des tailles de main estimées (la somme
+    // des tailles reste égale au nombre de cartes inconnues)
+    void addSeat(uint64_t player) {
+        if (seats_ & seatBit(player)) return;
+        seats_ |= seatBit(player);
+        if (player == me_) return;
+
+        const int total = count(unknown());
+        int assigned = 0;
+        for (int p = 0; p < MAX_PLAYERS; ++p)
+            if (isOpponent(p) && static_cast<uint64_t>(p) != player) assigned += counts_[p];
+        const int share = total / count(seats_ & ~seatBit(me_));
+
+        possible_[player] = unknown();
+        counts_[player]   = std::max(0, std::min(share, total - assigned));
+        while (counts_[player] < share) {
+            int richest = -1;
+            for (int p = 0; p < MAX_PLAYERS; ++p)
+                if (isOpponent(p) && static_cast<uint64_t>(p) != player &&
+                    (richest < 0 || counts_[p] > counts_[richest])) richest = p;
+            if (richest < 0 || counts_[richest] <= counts_[player]) break;
+            --counts_[richest];
+            ++counts_[player];
+        }
+    }
+
+    // Le joueur pose une carte : sa main diminue (on corrige l'estimation si besoin)
+    void takeFrom(uint64_t player) {
+        if (player >= MAX_PLAYERS || player == me_) return;
+        if (counts_[player] > 0) { --counts_[player]; return; }
+        int richest = -1;
+        for (int p = 0; p < MAX_PLAYERS; ++p)
+            if (isOpponent(p) && (richest < 0 || counts_[p] > counts_[richest])) richest = p;
+        if (richest >= 0 && counts_[richest] > 0) --counts_[richest];
+    }
+
+    // Tirage uniforme dans [0, n) par multiplication (Lemire), sans division
+    template <class URNG>
+    static int below(URNG& rng, int n) {
+        return static_cast<int>((static_cast<uint64_t>(static_cast<uint32_t>(rng())) * n) >> 32);
+    }
+
+    // strict : tailles de main exactes ; sinon elles ne servent que de poids
+    template <class URNG>
+    bool trySample(URNG& rng, Hands& hands, bool strict) const {
+        hands = {};
+        int  opp[MAX_PLAYERS];
+        int  room[MAX_PLAYERS];
+        Mask poss[MAX_PLAYERS];
+        int  nOpp = 0;
+        for (int p = 0; p < MAX_PLAYERS; ++p) {
+            if (!isOpponent(p)) continue;
+            opp[nOpp]  = p;
+            room[nOpp] = counts_[p];
+            poss[nOpp] = possible_[p];
+            ++nOpp;
+        }
+        Mask rest = unknown();
+        if (nOpp == 0) return rest == 0;
+
+        // 1) Cartes qu'un seul adversaire peut détenir
+        Mask once = 0, twice = 0;
+        for (int k = 0; k < nOpp; ++k) {
+            twice |= once & poss[k];
+            once  |= poss[k];
+        }
+        const Mask forced = once & ~twice & rest;
+        for (int k = 0; k < nOpp; ++k) {
+            const Mask mine = poss[k] & forced;
+            hands[opp[k]] |= mine;
+            room[k] -= count(mine);
+            if (strict && room[k] < 0) return false;
+        }
+        rest &= ~forced;
+
+        // 2) Le reste, carte par carte, au prorata de la place restante
+        while (rest) {
+            const Mask b = rest & (~rest + 1);
+            rest &= rest - 1;
+
+            int weight[MAX_PLAYERS];
+            int total = 0;
+            for (int k = 0; k < nOpp; ++k) {
+                const bool can = (poss[k] & b) != 0;
+                weight[k] = !can ? 0 : room[k] > 0 ? (strict ? room[k] : 4 * room[k]) : (strict ? 0 : 1);
+                total += weight[k];
+            }
+            if (total == 0) {
+                if (strict) return false;
+                for (int k = 0; k < nOpp; ++k) weight[k] = 1;
+                total = nOpp;
+            }
+
+            int pick = below(rng, total);
+            int k = 0;
+            while (pick >= weight[k]) pick -= weight[k++];
+            hands[opp[k]] |= b;
+            --room[k];
+        }
+        return true;
+    }
+
+    uint64_t me_ = 0;
+    uint32_t seats_ = 0;           // sièges vus (bit p)
+    uint32_t untrusted_ = 0;       // sièges dont les passes ne prouvent rien
+    uint32_t untrustedSinceSync_ = 0;
+    int      forcedPlayers_ = 0;
+    Mask     hand_ = 0;
+    Mask     table_ = 0;
+    Hands    possible_{};
+    std::array<int, MAX_PLAYERS> counts_{};
+    std::array<PendingMove, MAX_PENDING> pending_{};
+    int      pendingMoves_ = 0;
+};
+
+} // namespace sevens
@@ -0,0 +1,189 @@
+#include "Perft.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace sevens {
+
+namespace {
+
+using Mask = RoundState::Mask;
+
+constexpr int MAX_DEPTH = 511;   // 9 bits dans la clé de la table
+
+struct Count {
+    uint64_t nodes = 0;
+    uint64_t ended = 0;
+};
+
+// Table de transposition d'un thread : remplacement systématique, clé exacte
+class TranspositionTable {
+public:
+    explicit TranspositionTable(std::size_t bytes) {
+        std::size_t n = 1;
+        while (n * 2 * sizeof(Entry) <= bytes) n *= 2;
+        if (bytes >= sizeof(Entry)) entries_.resize(n);
+        mask_ = n - 1;
+    }
+
+    bool enabled() const { return !entries_.empty(); }
+
+    bool probe(uint64_t key, Count& c) const {
+        const Entry& e = entries_[slot(key)];
+        if (e.key != key) return false;
+        c = e.count;
+        return true;
+    }
+
+    void store(uint64_t key, const Count& c) { entries_[slot(key)] = {key, c}; }
+
+private:
+    struct Entry {
+        uint64_t key = 0;   // jamais 0 : le 7♦ est toujours posé
+        Count    count;
+    };
+
+    std::size_t slot(uint64_t key) const {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 20) & mask_;
+    }
+
+    std::vector<Entry> entries_;
+    std::size_t        mask_ = 0;
+};
+
+Count search(const RoundState& s, int depth, TranspositionTable& tt)
+{
+    if (depth == 0) return {1, 0};
+    if (s.over())   return {0, 1};
+
+    Mask moves = s.moves();
+    if (depth == 1)   // comptage direct des feuilles
+        return {moves ? static_cast<uint64_t>(__builtin_popcountll(moves)) : 1, 0};
+
+    const uint64_t key = s.key() | static_cast<uint64_t>(depth) << 55;
+    Count total;
+    if (tt.enabled() && tt.probe(key, total))
+        return total;
+
+    if (!moves) {
+        RoundState child = s;
+        child.pass();
+        total = search(child, depth - 1, tt);
+    }
+    while (moves) {
+        const Mask card = moves & (~moves + 1);
+        moves &= moves - 1;
+        RoundState child = s;
+        child.play(card);
+        const Count c = search(child, depth - 1, tt);
+        total.nodes += c.nodes;
+        total.ended += c.ended;
+    }
+
+    if (tt.enabled()) tt.store(key, total);
+    return total;
+}
+
+// Sous-arbre à explorer : position, profondeur restante, premier coup d'origine
+struct Task {
+    RoundState state;
+    int        depth;
+    std::size_t root;
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Compte les séquences de coups, réparties entre threads
+PerftResult perft(const RoundState& start, const PerftOptions& options)
+{
+    if (options.depth < 1 || options.depth > MAX_DEPTH)
+        throw std::invalid_argument("perft depth must be between 1 and " + std::to_string(MAX_DEPTH));
+    if (start.numPlayers < 1 || start.numPlayers > RoundState::MAX_PLAYERS)
+        throw std::invalid_argument("perft needs 1 to 8 players");
+
+    const unsigned threads = std::max(1u, options.threads);
+    PerftResult result;
+
+    // 1) Premier coup : une racine par carte jouable (ou une seule passe)
+    std::vector<Task> tasks;
+    if (start.over()) {
+        result.ended = 1;
+        return result;
+    }
+    Mask moves = start.moves();
+    if (!moves) {
+        RoundState child = start;
+        child.pass();
+        result.roots.push_back({0});
+        tasks.push_back({child, options.depth - 1, 0});
+    }
+    while (moves) {
+        const Mask card = moves & (~moves + 1);
+        moves &= moves - 1;
+        RoundState child = start;
+        child.play(card);
+        result.roots.push_back({card});
+        tasks.push_back({child, options.depth - 1, result.roots.size() - 1});
+    }
+
+    // 2) On développe les plis suivants tant qu'il y a trop peu de travail
+    while (tasks.size() < 4 * threads) {
+        std::vector<Task> next;
+        bool grew = false;
+        for (const Task& t : tasks) {
+            if (t.depth <= 1 || t.state.over()) {
+                next.push_back(t);
+                continue;
+            }
+            grew = true;
+            Mask m = t.state.moves();
+            if (!m) {
+                RoundState child = t.state;
+                child.pass();
+                next.push_back({child, t.depth - 1, t.root});
+            }
+            while (m) {
+                const Mask card = m & (~m + 1);
+                m &= m - 1;
+                RoundState child = t.state;
+                child.play(card);
+                next.push_back({child, t.depth - 1, t.root});
+            }
+        }
+        tasks.swap(next);
+        if (!grew) break;
+    }
+
+    // 3) Exploration parallèle, une table de transposition par thread
+    std::vector<Count> taskCounts(tasks.size());
+    std::atomic<std::size_t> nextTask{0};
+    auto worker = [&] {
+        TranspositionTable tt(options.ttBytes / threads);
+        for (std::size_t i; (i = nextTask.fetch_add(1)) < tasks.size(); )
+            taskCounts[i] = search(tasks[i].state, tasks[i].depth, tt);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool)
+        th.join();
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        auto& root = result.roots[tasks[i].root];
+        root.nodes += taskCounts[i].nodes;
+        root.ended += taskCounts[i].ended;
+    }
+    for (const auto& root : result.roots) {
+        result.nodes += root.nodes;
+        result.ended += root.ended;
+    }
+    return result;
+}
+
+} // namespace sevens
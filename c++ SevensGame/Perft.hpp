@@ -0,0 +1,43 @@
+#pragma once
+
+#include "RoundState.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Exhaustive enumeration of the legal move sequences of a round ("perft").
+ *
+ * Every ply is one turn: a legal card, or a pass when the seat to move has
+ * none. perft() counts the sequences of exactly `depth` plies and, apart,
+ * the shorter ones that finish the round. The counts only depend on the
+ * rules, so they are a reference for any faster rules implementation, and
+ * the run time is a move-generation benchmark.
+ *
+ * The work is split between threads over the first plies; each thread can
+ * use its own transposition table keyed on (table, seat to move, depth).
+ */
+struct PerftOptions {
+    int         depth    = 1;
+    unsigned    threads  = 1;
+    std::size_t ttBytes  = 0;   // total for all threads, 0 = no table
+};
+
+struct PerftResult {
+    uint64_t nodes = 0;   // sequences of exactly `depth` plies
+    uint64_t ended = 0;   // shorter sequences that finish the round
+
+    // Per first ply ("divide"): the card played, 0 for a pass
+    struct Root {
+        RoundState::Mask move = 0;
+        uint64_t nodes = 0;
+        uint64_t ended = 0;
+    };
+    std::vector<Root> roots;
+};
+
+PerftResult perft(const RoundState& start, const PerftOptions& options);
+
+} // namespace sevens
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Generic_card_parser.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -8,6 +13,44 @@
 namespace sevens
 {
 
+using DecisionClock = std::chrono::steady_clock;
+
+/**
+ * Where an anytime strategy publishes its best move so far. When a time
+ * control is active and the deadline passes, the engine plays the latest
+ * published index (or passes if nothing was published).
+ */
+class DecisionSlot
+{
+public:
+    void publish(int index) { best_.store(index, std::memory_order_release); }
+    int  latest() const     { return best_.load(std::memory_order_acquire); }
+    void clear()            { best_.store(-1, std::memory_order_relaxed); }
+
+private:
+    std::atomic<int> best_{-1};
+};
+
+/**
+ * Public state of the round after an event, handed to pondering strategies.
+ * Immutable and shared by every ponderer of the same event.
+ */
+struct PublicState
+{
+    static constexpr int MAX_PLAYERS = 8;
+
+    std::uint64_t table      = 0;    // cards on the table (bit = CardId value)
+    std::uint32_t events     = 0;    // moves and passes since the deal
+    int           numPlayers = 0;
+    std::array<std::uint64_t, MAX_PLAYERS> seat{};       // player IDs, in turn order
+    std::array<std::uint8_t,  MAX_PLAYERS> handSize{};   // cards left, same order
+    int           toMove     = 0;    // index in seat[] of the next player
+    int           lastSeat   = -1;   // index of the last player to act
+    int           lastCard   = -1;   // CardId value it played, -1 for a pass
+};
+
+using PublicSnapshot = std::shared_ptr<const PublicState>;
+
 /**
  * Interface every strategy must implement.
  * We keep the original camelCase method names so legacy code builds.
@@ -27,12 +70,52 @@ public:
         const std::unordered_map<std::uint64_t,
               std::unordered_map<std::uint64_t,bool>>& tableLayout) = 0;
 
+    /// Deadline-aware variant, the one the engine calls. Search-based
+    /// strategies override it, publish() improving answers into `slot` and
+    /// return by `deadline` (DecisionClock::time_point::max() = no limit).
+    /// The default ignores both and calls the overload above.
+    virtual int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<std::uint64_t,
+              std::unordered_map<std::uint64_t,bool>>& tableLayout,
+        DecisionClock::time_point deadline,
+        DecisionSlot& slot)
+    {
+        (void)deadline;
+        (void)slot;
+        return selectCardToPlay(hand, tableLayout);
+    }
+
     // notifications -----------------------------------------------------------
     virtual void observeMove (std::uint64_t playerID, const Card& playedCard) = 0;
     virtual void observePass (std::uint64_t playerID)                        = 0;
 
+    // pondering (opt-in, see MyGameMapper::setPondering) ------------------------
+    /// Return true to be given ponder() calls while other players think.
+    virtual bool wantsPonder() const { return false; }
+
+    /// Runs on an engine thread after each event, with the public state,
+    /// while others decide. Think until `stop` becomes true and keep what
+    /// helps the next decision: the engine stops and waits for ponder()
+    /// before calling any other method, so nothing here needs locking.
+    /// Must not use scratch(), which is shared with the engine thread.
+    virtual void ponder(const PublicSnapshot& state, const std::atomic<bool>& stop)
+    {
+        (void)state;
+        (void)stop;
+    }
+
     // meta -------------------------------------------------------------------
     virtual std::string getName() const = 0;
+
+    // scratch memory ----------------------------------------------------------
+    /// Per-round arena set by the engine (see ScratchArena); reset before
+    /// every deal, so use it for per-decision temporaries only.
+    void attachScratch(std::pmr::memory_resource* arena) { scratch_ = arena; }
+    std::pmr::memory_resource* scratch() const { return scratch_; }
+
+protected:
+    std::pmr::memory_resource* scratch_ = std::pmr::get_default_resource();
 };
 
 // C-ABI factory signature looked up by StrategyLoader
@@ -0,0 +1,86 @@
+#include "PonderWorker.hpp"
+
+#include <utility>
+
+namespace sevens {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Annule la réflexion en cours puis arrête le thread
+PonderWorker::~PonderWorker()
+{
+    if (!worker.joinable())
+        return;
+    halt();   // une exception de ponder() est abandonnée avec le thread
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        quitting = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lance une réflexion sur le nouvel état public
+void PonderWorker::start(PublicSnapshot state)
+{
+    stop();
+    if (!worker.joinable())
+        worker = std::thread(&PonderWorker::loop, this);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    cancel.store(false, std::memory_order_relaxed);
+    pending = std::move(state);
+    busy = true;
+    ++started;
+    cv.notify_all();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Demande l'arrêt, attend ponder() et relance son exception éventuelle
+void PonderWorker::stop()
+{
+    halt();
+    std::lock_guard<std::mutex> lock(mtx);
+    if (failure)
+        std::rethrow_exception(std::exchange(failure, nullptr));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Demande l'arrêt et attend que ponder() rende la main
+void PonderWorker::halt()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    if (!busy)
+        return;
+    cancel.store(true, std::memory_order_release);
+    cv.wait(lock, [this] { return !busy; });
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Boucle du thread : une réflexion par état reçu
+void PonderWorker::loop()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        cv.wait(lock, [this] { return quitting || (busy && pending); });
+        if (quitting)
+            return;
+        PublicSnapshot state = std::move(pending);
+        pending = nullptr;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            if (!cancel.load(std::memory_order_acquire))
+                strategy.ponder(state, cancel);
+        } catch (...) {   // une exception hors du thread terminerait le processus
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error && !failure)
+            failure = error;
+        busy = false;
+        cv.notify_all();
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace sevens {
+
+/**
+ * Background thread on which one strategy ponders between its turns.
+ *
+ * start() hands the latest public snapshot to the thread; stop() raises the
+ * strategy's stop flag and blocks until ponder() has returned, so the engine
+ * can then call the strategy from its own thread. The thread is created on
+ * first use and kept for the whole match.
+ */
+class PonderWorker {
+public:
+    explicit PonderWorker(PlayerStrategy& strategy) : strategy(strategy) { }
+    ~PonderWorker();
+
+    PonderWorker(const PonderWorker&) = delete;
+    PonderWorker& operator=(const PonderWorker&) = delete;
+
+    // Stops the current ponder, if any, and starts one on `state`
+    void start(PublicSnapshot state);
+
+    // Cancels the current ponder and waits for it; no-op when idle. Rethrows
+    // on the caller's thread an exception thrown by ponder()
+    void stop();
+
+    // Ponder calls started so far
+    uint64_t runs() const { return started; }
+
+private:
+    void loop();
+    void halt();
+
+    PlayerStrategy&         strategy;
+    std::thread             worker;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    PublicSnapshot          pending;
+    std::exception_ptr      failure;     // exception de ponder() pas encore relancée
+    std::atomic<bool>       cancel{false};
+    bool                    busy = false;
+    bool                    quitting = false;
+    uint64_t                started = 0;
+};
+
+} // namespace sevens
@@ -15,26 +15,6 @@ RandomStrategy::RandomStrategy() {
     rng.seed(seed);
 }
 
-void RandomStrategy::initialize(uint64_t playerID) {
-    myID = playerID;
-}
-
-int RandomStrategy::selectCardToPlay(
-    const std::vector<Card>& hand,
-    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout)
-{
-    (void)tableLayout;  // suppress unused-parameter warning
-    if (hand.empty()) {
-        return -1; // pass
-    }
-
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(hand.size()) - 1);
-    return dist(rng);
-}
-
-void RandomStrategy::observeMove(uint64_t /*playerID*/, const Card& /*playedCard*/) {}
-void RandomStrategy::observePass(uint64_t /*playerID*/) {}
-
 std::string RandomStrategy::getName() const {
     return "RandomStrategy";
 }
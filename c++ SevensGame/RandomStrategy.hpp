@@ -8,19 +8,31 @@ namespace sevens {
 
 /**
  * A simple strategy that selects a random playable card.
+ *
+ * final, with the per-turn methods defined here, so StaticGameEngine can
+ * inline them into its round loop.
  */
-class RandomStrategy : public PlayerStrategy {
+class RandomStrategy final : public PlayerStrategy {
 public:
     RandomStrategy();
     ~RandomStrategy() override = default;
     
     // PlayerStrategy interface
-    void initialize(uint64_t playerID) override;
+    void initialize(uint64_t playerID) override { myID = playerID; }
     int selectCardToPlay(
         const std::vector<Card>& hand,
-        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
-    void observeMove(uint64_t playerID, const Card& playedCard) override;
-    void observePass(uint64_t playerID) override;
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        (void)tableLayout;  // suppress unused-parameter warning
+        if (hand.empty()) {
+            return -1; // pass
+        }
+
+        std::uniform_int_distribution<int> dist(0, static_cast<int>(hand.size()) - 1);
+        return dist(rng);
+    }
+    void observeMove(uint64_t /*playerID*/, const Card& /*playedCard*/) override {}
+    void observePass(uint64_t /*playerID*/) override {}
     std::string getName() const override;
     
 private:
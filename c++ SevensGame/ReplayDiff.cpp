@@ -0,0 +1,209 @@
+#include "ReplayDiff.hpp"
+#include "CardId.hpp"
+#include "ScratchArena.hpp"
+#include "StrategyLoader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace sevens {
+
+namespace {
+
+using TableLayout = std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>;
+
+// Coup effectivement joué pour une réponse : carte légale, sinon passe (-1)
+int effective(int idx, const std::vector<Card>& hand, uint64_t table)
+{
+    if (idx < 0 || static_cast<std::size_t>(idx) >= hand.size())
+        return -1;
+    const CardId c(hand[idx]);
+    return (card_masks::legal(table) & c.bit()) ? c.value : -1;
+}
+
+// Résultats d'un thread, fusionnés à la fin
+struct Partial {
+    uint64_t decisions = 0;
+    uint64_t differences = 0;
+    std::vector<ReplayReport::Build> builds;
+    std::vector<ReplayDifference> shown;
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rejoue chaque décision du journal sur une ou deux versions d'une stratégie
+ReplayReport replay_diff(const DecisionLog& log, const ReplayOptions& opt)
+{
+    const std::size_t nBuilds = opt.builds.size();
+    if (nBuilds < 1 || nBuilds > 2)
+        throw std::invalid_argument("replay-diff compares one or two builds");
+    const std::size_t nSeats = log.seatNames.size();
+
+    PluginCache plugins;
+    ReplayReport report;
+    for (const auto& path : opt.builds)
+        report.builds.push_back({plugins.create(path)->getName()});
+
+    // Sièges rejoués : ceux de la stratégie testée, sinon tous
+    std::vector<bool> replayed(nSeats, opt.allSeats);
+    if (!opt.allSeats)
+        for (std::size_t s = 0; s < nSeats; ++s)
+            replayed[s] = log.seatNames[s] == report.builds[0].name;
+    if (std::find(replayed.begin(), replayed.end(), true) == replayed.end())
+        replayed.assign(nSeats, true);
+    for (std::size_t s = 0; s < nSeats; ++s)
+        if (replayed[s]) report.seats.push_back(static_cast<uint32_t>(s));
+
+    std::atomic<std::size_t> nextGame{0};
+    std::mutex mtx;
+    std::vector<Partial> partials;
+    std::exception_ptr failure;
+
+    auto worker = [&] {
+        try {
+            Partial part;
+            part.builds = report.builds;
+
+            // Instances propres au thread : [version][siège]
+            std::vector<std::unique_ptr<ScratchArena>> arenas;
+            std::vector<std::vector<std::shared_ptr<PlayerStrategy>>> inst(nBuilds);
+            for (std::size_t b = 0; b < nBuilds; ++b) {
+                arenas.push_back(std::make_unique<ScratchArena>());
+                inst[b].resize(nSeats);
+                for (std::size_t s = 0; s < nSeats; ++s)
+                    if (replayed[s]) {
+                        inst[b][s] = plugins.create(opt.builds[b]);
+                        inst[b][s]->attachScratch(arenas[b]->resource());
+                    }
+            }
+            auto each = [&](auto&& f) {
+                for (auto& perBuild : inst)
+                    for (auto& p : perBuild)
+                        if (p) f(*p);
+            };
+
+            std::vector<std::vector<Card>> hands(nSeats);
+            TableLayout layout;
+            uint64_t table = 0;
+
+            for (std::size_t g; (g = nextGame.fetch_add(1)) < log.games.size(); ) {
+                const std::string& ev = log.games[g];
+                for (std::size_t s = 0; s < nSeats; ++s)
+                    for (std::size_t b = 0; b < nBuilds; ++b)
+                        if (inst[b][s]) inst[b][s]->initialize(s);
+
+                uint32_t round = 0;
+                for (std::size_t pos = 0; pos < ev.size(); ) {
+                    const char tag = ev[pos++];
+                    if (tag == 'R') {
+                        for (auto& h : hands) {
+                            h.clear();
+                            const std::size_t n = static_cast<unsigned char>(ev[pos++]);
+                            for (std::size_t k = 0; k < n; ++k)
+                                h.push_back(CardId(static_cast<uint8_t>(ev[pos++])).toCard());
+                        }
+                        for (uint64_t suit = 0; suit < 4; ++suit)
+                            for (uint64_t rank = 1; rank <= 13; ++rank)
+                                layout[suit][rank] = false;
+                        layout[1][7] = true;
+                        table = SEVEN_OF_DIAMONDS.bit();
+                        for (auto& a : arenas) a->reset();
+                        ++round;
+                        continue;
+                    }
+
+                    // 'M' ou 'P' : réponse à une décision du siège
+                    const std::size_t seat = static_cast<unsigned char>(ev[pos++]);
+                    const int recorded = tag == 'M' ? static_cast<unsigned char>(ev[pos++]) : -1;
+
+                    if (replayed[seat]) {
+                        int answers[2] = {-1, -1};
+                        for (std::size_t b = 0; b < nBuilds; ++b) {
+                            DecisionSlot slot;
+                            const auto t0 = std::chrono::steady_clock::now();
+                            const int idx = inst[b][seat]->selectCardToPlay(
+                                hands[seat], layout, DecisionClock::time_point::max(), slot);
+                            const double ns = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - t0).count();
+                            auto& st = part.builds[b];
+                            st.totalNs += ns;
+                            st.maxNs = std::max(st.maxNs, ns);
+                            answers[b] = effective(idx, hands[seat], table);
+                            if (answers[b] != recorded) ++st.offRecord;
+                        }
+                        ++part.decisions;
+
+                        const bool differs = nBuilds == 1 ? answers[0] != recorded
+                                                          : answers[0] != answers[1];
+                        if (differs) {
+                            ++part.differences;
+                            if (part.shown.size() < opt.maxShown)
+                                part.shown.push_back({g, round, static_cast<uint32_t>(seat), hands[seat],
+                                                      table, recorded, {answers[0], answers[1]}});
+                        }
+                    }
+
+                    // Le coup enregistré est appliqué et observé, quoi qu'aient répondu les versions
+                    if (tag == 'M') {
+                        const CardId c(static_cast<uint8_t>(recorded));
+                        auto& h = hands[seat];
+                        const auto it = std::find_if(h.begin(), h.end(),
+                                                     [&](const Card& x) { return CardId(x) == c; });
+                        if (it == h.end())
+                            throw std::runtime_error("decision log: card played from outside the hand");
+                        h.erase(it);
+                        table |= c.bit();
+                        const Card card = c.toCard();
+                        layout[card.suit][card.rank] = true;
+                        each([&](PlayerStrategy& p) { p.observeMove(seat, card); });
+                    } else {
+                        each([&](PlayerStrategy& p) { p.observePass(seat); });
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            partials.push_back(std::move(part));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!failure) failure = std::current_exception();
+            nextGame = log.games.size();
+        }
+    };
+
+    const unsigned threads = std::max(1u, opt.threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool)
+        th.join();
+    if (failure)
+        std::rethrow_exception(failure);
+
+    // Fusion : chaque thread a traité ses parties dans l'ordre croissant
+    for (auto& part : partials) {
+        report.decisions += part.decisions;
+        report.differences += part.differences;
+        for (std::size_t b = 0; b < nBuilds; ++b) {
+            report.builds[b].offRecord += part.builds[b].offRecord;
+            report.builds[b].totalNs   += part.builds[b].totalNs;
+            report.builds[b].maxNs      = std::max(report.builds[b].maxNs, part.builds[b].maxNs);
+        }
+        report.shown.insert(report.shown.end(), part.shown.begin(), part.shown.end());
+    }
+    std::stable_sort(report.shown.begin(), report.shown.end(),
+                     [](const auto& a, const auto& b) { return a.game < b.game; });
+    if (report.shown.size() > opt.maxShown)
+        report.shown.resize(opt.maxShown);
+    return report;
+}
+
+} // namespace sevens
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "DecisionLog.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Regression check of strategy builds against a decision log: every
+ * recorded decision is put again to one or two plugin builds, with the
+ * same hand, table and observation history, and their answers compared
+ * (one build: with the recorded action; two builds: with each other).
+ *
+ * After each decision the recorded move or pass is applied and observed,
+ * whatever the builds answered, so their state follows the recorded game.
+ * Games are independent and spread over threads, each with its own
+ * strategy instances.
+ *
+ * Only the seats whose recorded name matches the first build's getName()
+ * are replayed, unless allSeats is set or no seat matches.
+ */
+struct ReplayOptions {
+    std::vector<std::string> builds;      // 1 or 2 plugin paths
+    unsigned                 threads  = 1;
+    bool                     allSeats = false;
+    std::size_t              maxShown = 20;
+};
+
+struct ReplayDifference {
+    uint64_t          game  = 0;
+    uint32_t          round = 0;
+    uint32_t          seat  = 0;
+    std::vector<Card> hand;
+    uint64_t          table = 0;          // cards on the table (bit = CardId)
+    int               recorded = -1;      // CardId value, -1 = pass
+    int               answers[2] = {-1, -1};
+};
+
+struct ReplayReport {
+    uint64_t              decisions = 0;
+    std::vector<uint32_t> seats;          // seats replayed
+
+    struct Build {
+        std::string name;
+        uint64_t    offRecord = 0;        // decisions differing from the log
+        double      totalNs   = 0;
+        double      maxNs     = 0;
+    };
+    std::vector<Build> builds;
+
+    uint64_t differences = 0;             // build vs log, or build A vs build B
+    std::vector<ReplayDifference> shown;  // first maxShown differences, log order
+};
+
+ReplayReport replay_diff(const DecisionLog& log, const ReplayOptions& options);
+
+} // namespace sevens
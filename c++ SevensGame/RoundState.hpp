@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CardId.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+
+namespace sevens {
+
+/**
+ * One round of Sevens as a handful of 64-bit masks (bit = CardId value), for
+ * search and enumeration code that needs millions of positions per second.
+ *
+ * Rules are those of MyGameMapper::compute_game_progress with forced passes
+ * only: the seat to move plays one of its legal cards, and passes if and
+ * only if it holds none. Seats move in order 0..n-1 and the round is over
+ * when nobody can move any more (with legal play only, when every card is
+ * on the table).
+ *
+ * A hand is the dealt mask minus the table, so a position is fully given by
+ * (table, toMove): key() packs both into 55 bits.
+ */
+struct RoundState {
+    using Mask = uint64_t;
+    static constexpr int MAX_PLAYERS = 8;
+
+    std::array<Mask, MAX_PLAYERS> dealt{};
+    Mask    table      = SEVEN_OF_DIAMONDS.bit();
+    uint8_t numPlayers = 0;
+    uint8_t toMove     = 0;
+
+    /**
+     * Shuffles the full deck with `rng` and deals it like the engine: card i
+     * goes to seat i % n, the 7♦ (already on the table) to nobody. With
+     * MyGameMapper::seeded_rng(seed, g) this is the first deal of game g of a
+     * seeded series.
+     */
+    template <class URNG>
+    static RoundState deal(URNG& rng, int n) {
+        std::array<CardId, CardId::NUM_CARDS> deck = FULL_DECK;
+        std::shuffle(deck.begin(), deck.end(), rng);
+
+        RoundState s;
+        s.numPlayers = static_cast<uint8_t>(n);
+        for (std::size_t i = 0; i < deck.size(); ++i)
+            if (deck[i] != SEVEN_OF_DIAMONDS)
+                s.dealt[i % n] |= deck[i].bit();
+        return s;
+    }
+
+    Mask hand(int p) const { return dealt[p] & ~table; }
+    Mask legal() const { return card_masks::legal(table); }
+
+    // Cards the seat to move may play; 0 means it must pass
+    Mask moves() const { return hand(toMove) & legal(); }
+
+    bool over() const {
+        const Mask open = legal();
+        for (int p = 0; p < numPlayers; ++p)
+            if (dealt[p] & open) return false;
+        return true;
+    }
+
+    void play(Mask card) { table |= card; next(); }
+    void pass() { next(); }
+
+    uint64_t key() const { return table | static_cast<uint64_t>(toMove) << CardId::NUM_CARDS; }
+
+private:
+    void next() { toMove = static_cast<uint8_t>(toMove + 1 == numPlayers ? 0 : toMove + 1); }
+};
+
+} // namespace sevens
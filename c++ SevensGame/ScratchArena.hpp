@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace sevens {
+
+/**
+ * Scratch memory for strategies, owned by the engine (one per
+ * MyGameMapper, hence one per simulation thread).
+ *
+ * A monotonic arena over a buffer allocated once: allocations are a pointer
+ * bump, deallocations are no-ops, and reset() rewinds everything at once.
+ * The engine resets it before each deal, so strategies must not keep
+ * pointers into it from one round to the next. If a round needs more than
+ * the initial buffer, extra chunks come from the global heap and are
+ * returned by the next reset().
+ */
+class ScratchArena {
+public:
+    explicit ScratchArena(std::size_t initialBytes = 64 * 1024)
+        : buffer_(new std::byte[initialBytes]),
+          arena_(buffer_.get(), initialBytes, std::pmr::new_delete_resource())
+    { }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena_; }
+
+    void reset() { arena_.release(); }
+
+private:
+    std::unique_ptr<std::byte[]>        buffer_;
+    std::pmr::monotonic_buffer_resource arena_;
+};
+
+} // namespace sevens
@@ -0,0 +1,301 @@
+#include "SelfTest.hpp"
+#include "MyGameMapper.hpp"
+#include "OpponentBeliefs.hpp"
+#include "RoundState.hpp"
+#include "SevensFeatures.hpp"
+#include "SuitSymmetry.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+namespace sevens {
+
+namespace {
+
+using Mask = RoundState::Mask;
+
+// Main d'un siège au format reçu par les stratégies
+std::vector<Card> cards_of(Mask mask)
+{
+    std::vector<Card> hand;
+    for (; mask; mask &= mask - 1)
+        hand.push_back(CardId(static_cast<uint8_t>(__builtin_ctzll(mask))).toCard());
+    return hand;
+}
+
+// Table au format reçu par les stratégies
+std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>> layout_of(Mask table)
+{
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>> layout;
+    for (; table; table &= table - 1) {
+        const Card c = CardId(static_cast<uint8_t>(__builtin_ctzll(table))).toCard();
+        layout[static_cast<uint64_t>(c.suit)][static_cast<uint64_t>(c.rank)] = true;
+    }
+    return layout;
+}
+
+// Carte tirée au hasard parmi un masque non vide
+template <class URNG>
+CardId pick(URNG& rng, Mask mask)
+{
+    int k = static_cast<int>(rng() % static_cast<unsigned>(__builtin_popcountll(mask)));
+    for (; k > 0; --k)
+        mask &= mask - 1;
+    return CardId(static_cast<uint8_t>(__builtin_ctzll(mask)));
+}
+
+// Compte un contrôle ; seul le premier échec est décrit
+class Tally {
+public:
+    explicit Tally(SelfTestResult& r) : r(r) { }
+
+    template <class Describe>
+    void expect(bool ok, Describe&& describe) {
+        ++r.checks;
+        if (ok) return;
+        if (r.failures++ == 0) {
+            std::ostringstream out;
+            describe(out);
+            r.firstFailure = out.str();
+        }
+    }
+
+private:
+    SelfTestResult& r;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OpponentBeliefs : un observateur par siège, sièges appris ou déclarés
+SelfTestResult check_beliefs(uint64_t seed, uint64_t rounds)
+{
+    SelfTestResult res;
+    res.name = "beliefs";
+    Tally t(res);
+    OpponentBeliefs::Hands sample;
+
+    for (int n = 2; n <= RoundState::MAX_PLAYERS; ++n) {
+        for (uint64_t r = 0; r < rounds; ++r) {
+            auto rng = MyGameMapper::seeded_rng(seed, static_cast<uint64_t>(n) * rounds + r);
+            RoundState s = RoundState::deal(rng, n);
+
+            std::vector<OpponentBeliefs> obs;
+            for (int me = 0; me < n; ++me)
+                for (bool declared : {false, true}) {
+                    OpponentBeliefs b(static_cast<uint64_t>(me));
+                    if (declared) b.setNumPlayers(n);
+                    b.startRound(cards_of(s.hand(me)));
+                    obs.push_back(b);
+                }
+
+            for (int ply = 0; !s.over(); ++ply) {
+                const int p = s.toMove;
+                if (const Mask m = s.moves()) {
+                    const CardId c = pick(rng, m);
+                    s.play(c.bit());
+                    for (auto& b : obs) b.observeMove(static_cast<uint64_t>(p), c);
+                } else {
+                    s.pass();
+                    for (auto& b : obs) b.observePass(static_cast<uint64_t>(p));
+                }
+
+                for (std::size_t i = 0; i < obs.size(); ++i) {
+                    const OpponentBeliefs& b = obs[i];
+                    const int  me       = static_cast<int>(i / 2);
+                    const bool declared = i % 2 == 1;
+                    auto where = [&](std::ostream& o) {
+                        o << n << " seats, round " << r << ", ply " << ply << ", seat " << me
+                          << (declared ? " (declared seats)" : " (learned seats)") << ": ";
+                    };
+
+                    t.expect(b.hand() == s.hand(me) && b.table() == s.table,
+                             [&](std::ostream& o) { where(o); o << "own hand or table out of sync"; });
+
+                    int opponents = 0, sizes = 0;
+                    for (int q = 0; q < OpponentBeliefs::MAX_PLAYERS; ++q) {
+                        if (!b.isOpponent(q)) continue;
+                        ++opponents;
+                        sizes += b.handSize(q);
+                        t.expect(q < n, [&](std::ostream& o) { where(o); o << "phantom seat " << q; });
+                        if (q >= n) continue;
+                        const Mask missed = s.hand(q) & ~b.possible(q);
+                        t.expect(missed == 0, [&](std::ostream& o) {
+                            where(o);
+                            o << "seat " << q << " holds " << CardId(static_cast<uint8_t>(__builtin_ctzll(missed)))
+                              << " outside its mask";
+                        });
+                    }
+                    if (declared)
+                        t.expect(opponents == n - 1,
+                                 [&](std::ostream& o) { where(o); o << opponents << " opponents tracked"; });
+                    if (opponents > 0)
+                        t.expect(sizes == OpponentBeliefs::count(b.unknown()), [&](std::ostream& o) {
+                            where(o);
+                            o << "hand sizes sum to " << sizes << " for "
+                              << OpponentBeliefs::count(b.unknown()) << " unknown cards";
+                        });
+
+                    // Tirage : chaque carte inconnue à un adversaire qui peut la tenir
+                    if (ply % 8 != 0 || !b.sample(rng, sample)) continue;
+                    Mask dealt = 0;
+                    for (int q = 0; q < OpponentBeliefs::MAX_PLAYERS; ++q) {
+                        if (!b.isOpponent(q)) continue;
+                        dealt |= sample[q];
+                        t.expect((sample[q] & ~b.possible(q)) == 0,
+                                 [&](std::ostream& o) { where(o); o << "sample gives seat " << q << " a ruled-out card"; });
+                    }
+                    t.expect(dealt == b.unknown(),
+                             [&](std::ostream& o) { where(o); o << "sample does not deal exactly the unknown cards"; });
+                }
+            }
+        }
+    }
+    return res;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// GameFeatures : état incrémental comparé à une reconstruction complète
+SelfTestResult check_features(uint64_t seed, uint64_t rounds)
+{
+    using F = GameFeatures;
+    SelfTestResult res;
+    res.name = "features";
+    Tally t(res);
+
+    for (int n = 2; n <= RoundState::MAX_PLAYERS; ++n) {
+        for (uint64_t r = 0; r < rounds; ++r) {
+            auto rng = MyGameMapper::seeded_rng(seed ^ 0x5EED, static_cast<uint64_t>(n) * rounds + r);
+            std::vector<F> obs;
+            for (int me = 0; me < n; ++me)
+                obs.emplace_back(static_cast<uint64_t>(me));
+            std::array<uint64_t, F::MAX_PLAYERS> passes{};
+
+            // Deux manches : les compteurs de passes survivent à la nouvelle donne
+            for (int round = 0; round < 2; ++round) {
+                RoundState s = RoundState::deal(rng, n);
+                std::vector<bool> synced(n, false);
+                // Série de passes vue par chaque siège : sync() la remet à zéro
+                // quand il découvre la nouvelle donne (fin de manche inobservable)
+                std::vector<uint64_t> streak(n, 0);
+
+                for (int ply = 0; !s.over(); ++ply) {
+                    // Le siège à jouer se resynchronise, comme dans selectCardToPlay()
+                    const int p = s.toMove;
+                    if (obs[p].sync(cards_of(s.hand(p)), layout_of(s.table)))
+                        streak[p] = 0;
+                    synced[p] = true;
+
+                    if (const Mask m = s.moves()) {
+                        const CardId c = pick(rng, m);
+                        s.play(c.bit());
+                        for (auto& f : obs) f.observeMove(static_cast<uint64_t>(p), c);
+                        streak.assign(n, 0);
+                    } else {
+                        s.pass();
+                        for (auto& f : obs) f.observePass(static_cast<uint64_t>(p));
+                        ++passes[p];
+                        for (auto& k : streak) ++k;
+                    }
+
+                    for (int me = 0; me < n; ++me) {
+                        if (!synced[me]) continue;   // pas encore vu la nouvelle donne
+                        auto where = [&](std::ostream& o) {
+                            o << n << " seats, game " << r << " round " << round << ", ply " << ply
+                              << ", seat " << me << ": ";
+                        };
+
+                        // Reconstruction par sync() sur un objet neuf ; une main vide
+                        // ne se distingue pas de l'état initial, sync() n'y touche pas
+                        const F::Vector& got = obs[me].vector();
+                        if (s.hand(me)) {
+                            F fresh(static_cast<uint64_t>(me));
+                            fresh.sync(cards_of(s.hand(me)), layout_of(s.table));
+                            const F::Vector& want = fresh.vector();
+                            for (int i = 0; i < F::OWN_PASSES; ++i)
+                                t.expect(got[i] == want[i], [&](std::ostream& o) {
+                                    where(o);
+                                    o << "entry " << i << " is " << got[i] << ", rebuilt " << want[i];
+                                });
+                        }
+
+                        // Entrées liées aux passes : compteurs tenus par le contrôle
+                        uint64_t others = 0;
+                        for (int q = 0; q < n; ++q)
+                            if (q != me) others += passes[q];
+                        auto capped = [](uint64_t k) { return (k < 30 ? static_cast<float>(k) : 30.0f) / 30.0f; };
+                        bool ok = got[F::OWN_PASSES] == capped(passes[me])
+                               && got[F::OPPONENT_PASSES] == capped(others)
+                               && got[F::PASS_STREAK] == static_cast<float>(std::min<uint64_t>(streak[me], F::MAX_PLAYERS))
+                                                         / F::MAX_PLAYERS;
+                        for (int q = 0; q < F::MAX_PLAYERS; ++q)
+                            ok = ok && got[F::SEAT_PASSES + q] == capped(passes[q]);
+                        t.expect(ok, [&](std::ostream& o) { where(o); o << "pass counters differ"; });
+                    }
+                }
+            }
+        }
+    }
+    return res;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SuitSymmetry : même forme canonique pour les six permutations des couleurs
+// libres, et retour exact aux vraies couleurs
+SelfTestResult check_symmetry(uint64_t seed, uint64_t rounds)
+{
+    SelfTestResult res;
+    res.name = "symmetry";
+    Tally t(res);
+
+    for (int n = 2; n <= RoundState::MAX_PLAYERS; ++n) {
+        for (uint64_t r = 0; r < rounds; ++r) {
+            auto rng = MyGameMapper::seeded_rng(seed ^ 0x5017, static_cast<uint64_t>(n) * rounds + r);
+            RoundState s = RoundState::deal(rng, n);
+
+            for (int ply = 0; !s.over(); ++ply) {
+                if (const Mask m = s.moves()) s.play(pick(rng, m).bit());
+                else                          s.pass();
+
+                const int me = s.toMove;
+                uint64_t hand = s.hand(me), table = s.table;
+                const uint64_t hand0 = hand, table0 = table;
+                const SuitPermutation perm = canonicalize(hand, table);
+                auto where = [&](std::ostream& o) {
+                    o << n << " seats, round " << r << ", ply " << ply << ", seat " << me << ": ";
+                };
+
+                t.expect(perm.fromCanonical(hand) == hand0 && perm.fromCanonical(table) == table0 &&
+                         (hand & card_masks::suit(1)) == (hand0 & card_masks::suit(1)),
+                         [&](std::ostream& o) { where(o); o << "masks do not map back"; });
+                for (Mask h = hand0; h; h &= h - 1) {
+                    const CardId c(static_cast<uint8_t>(__builtin_ctzll(h)));
+                    t.expect(perm.fromCanonical(perm.toCanonical(c)) == c && (hand & perm.toCanonical(c).bit()),
+                             [&](std::ostream& o) { where(o); o << "card " << c << " does not map back"; });
+                }
+
+                // Les six relabellisations de Trèfle, Cœur et Pique
+                for (int c = 0; c < 3; ++c)
+                    for (int h = 0; h < 3; ++h) {
+                        if (c == h) continue;
+                        const SuitPermutation relabel = SuitPermutation::fromRanks(c, h, 3 - c - h);
+                        uint64_t h2 = relabel.toCanonical(hand0), t2 = relabel.toCanonical(table0);
+                        canonicalize(h2, t2);
+                        t.expect(h2 == hand && t2 == table,
+                                 [&](std::ostream& o) { where(o); o << "relabelled suits give another canonical form"; });
+                    }
+            }
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lance tous les contrôles
+std::vector<SelfTestResult> run_self_tests(uint64_t seed, uint64_t rounds)
+{
+    return {check_beliefs(seed, rounds), check_features(seed, rounds), check_symmetry(seed, rounds)};
+}
+
+} // namespace sevens
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Consistency checks of the header-only helpers strategies build on
+ * ("sevens_game selftest"), so that the main build compiles them and every
+ * change can be checked without a plugin.
+ *
+ * Each check plays seeded random rounds with legal moves only (RoundState),
+ * feeds every move and pass to the helper and compares its incremental state
+ * with the ground truth after each event:
+ *   - beliefs: OpponentBeliefs never rules out a card an opponent holds,
+ *     never invents a seat, keeps its hand sizes summing to the unknown
+ *     cards, and its samples respect the masks; 2 to 8 seats, with seats
+ *     learned from play or declared by setNumPlayers();
+ *   - features: a GameFeatures vector kept up to date by observeMove(),
+ *     observePass() and sync() equals a full rebuild from the hand and the
+ *     table, and its pass entries match counters kept by the check, over
+ *     two rounds per game;
+ *   - symmetry: canonicalize() gives the same masks for all six relabellings
+ *     of Clubs, Hearts and Spades, and its permutation maps masks and cards
+ *     back exactly.
+ *
+ * Results only depend on the seed.
+ */
+struct SelfTestResult {
+    std::string name;
+    uint64_t    checks   = 0;
+    uint64_t    failures = 0;
+    std::string firstFailure;
+};
+
+// `rounds` rounds per seat count and per check
+std::vector<SelfTestResult> run_self_tests(uint64_t seed, uint64_t rounds);
+
+} // namespace sevens
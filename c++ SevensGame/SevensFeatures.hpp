@@ -0,0 +1,275 @@
+#pragma once
+
+#include "CardId.hpp"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Game-state features shared by strategies and training pipelines.
+ *
+ * A GameFeatures object follows one seat through a game: it keeps 13-bit
+ * rank masks per suit for the own hand and the table, plus pass counters,
+ * and maintains a fixed-size feature vector from them. observeMove() and
+ * observePass() only refresh the entries they affect (one suit block and
+ * the global block), so nothing is recomputed from scratch per decision.
+ *
+ * Strategies are not told when a new round is dealt; call sync() with the
+ * hand and table received in selectCardToPlay(). It costs one pass over the
+ * hand and only rebuilds the state when the hand no longer matches what the
+ * observed moves predict (i.e. after a new deal).
+ *
+ * Vector layout (SIZE floats, 64-byte aligned, all values roughly in [0,1]):
+ *   [12*s + 0..11]  suit block for suit s (see SuitFeature)
+ *   [48 + 0..15]    global block (see GlobalFeature)
+ */
+class GameFeatures {
+public:
+    static constexpr int NUM_SUITS   = 4;
+    static constexpr int MAX_PLAYERS = 8;
+    static constexpr int SUIT_BLOCK  = 12;
+    static constexpr int SIZE        = 64;
+
+    enum SuitFeature {
+        HAND_COUNT = 0,   // own cards in the suit / 13
+        TABLE_LOW,        // lowest rank on the table / 13 (0 = suit not opened)
+        TABLE_HIGH,       // highest rank on the table / 13
+        OPENED,           // 1 if the suit's 7 is on the table
+        PLAYABLE,         // own cards playable right now / 2
+        RUN_DOWN,         // own cards playable in a row below the table / 6
+        RUN_UP,           // own cards playable in a row above the table / 6
+        BLOCKED,          // own cards that need someone else's card first / 12
+        UNSEEN,           // cards neither in hand nor on the table / 13
+        BLOCKERS,         // unseen cards sitting between the table and own cards / 12
+        REACH_DOWN,       // distance from the 7 to the lowest own card / 6
+        REACH_UP          // distance from the 7 to the highest own card / 6
+    };
+
+    enum GlobalFeature {
+        HAND_SIZE = 4 * SUIT_BLOCK,   // / 13
+        PLAYABLE_TOTAL,               // / 13
+        TABLE_TOTAL,                  // / 52
+        UNSEEN_TOTAL,                 // / 39
+        OPENED_SUITS,                 // / 4
+        OWN_PASSES,                   // / 30, capped
+        OPPONENT_PASSES,              // / 30, capped
+        PASS_STREAK,                  // passes since the last move / MAX_PLAYERS
+        SEAT_PASSES                   // 8 entries: passes of seat i / 30, capped
+    };
+
+    struct alignas(64) Vector {
+        float v[SIZE];
+        float  operator[](int i) const { return v[i]; }
+        float& operator[](int i)       { return v[i]; }
+    };
+
+    static constexpr uint16_t FULL_SUIT = 0x1FFF;
+
+    // ── bit helpers (rank 1..13 -> bit 0..12) ────────────────────────────────
+    static constexpr uint16_t bit(int rank) { return static_cast<uint16_t>(1u << (rank - 1)); }
+
+    // Ranks playable in a suit: neighbours of placed cards, or the 7
+    static constexpr uint16_t playableMask(uint16_t placed) {
+        return static_cast<uint16_t>(
+            ((((placed << 1) | (placed >> 1)) & FULL_SUIT) | bit(7)) & ~placed);
+    }
+
+    static int count(uint32_t mask) { return __builtin_popcount(mask); }
+
+    // ── life-cycle ───────────────────────────────────────────────────────────
+    explicit GameFeatures(uint64_t me = 0) { reset(me); }
+
+    // New game for seat `me`: empty hand, only 7♦ on the table, no passes
+    void reset(uint64_t me) {
+        me_ = me;
+        hand_  = {};
+        table_ = {};
+        table_[1] = bit(7);
+        seatPasses_ = {};
+        passStreak_ = 0;
+        vec_ = Vector{};
+        refreshAll();
+    }
+
+    // New round: given hand, only 7♦ on the table
+    void startRound(const std::vector<Card>& hand) {
+        hand_  = masksOf(hand);
+        table_ = {};
+        table_[1] = bit(7);
+        passStreak_ = 0;
+        refreshAll();
+    }
+
+    // Resynchronise on a new deal; returns true if the state was rebuilt
+    bool sync(const std::vector<Card>& hand,
+              const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table)
+    {
+        const auto h = masksOf(hand);
+        if (h == hand_) return false;
+        hand_  = h;
+        table_ = masksOf(table);
+        passStreak_ = 0;
+        refreshAll();
+        return true;
+    }
+
+    // ── incremental updates ──────────────────────────────────────────────────
+    void observeMove(uint64_t player, CardId card) {
+        const int      s = card.suit();
+        const uint16_t b = bit(card.rank());
+        table_[s] |= b;
+        if (player == me_) hand_[s] &= static_cast<uint16_t>(~b);
+        passStreak_ = 0;
+        refreshSuit(s);
+        refreshGlobal();
+    }
+
+    void observePass(uint64_t player) {
+        if (player < MAX_PLAYERS && seatPasses_[player] < UINT16_MAX) ++seatPasses_[player];
+        ++passStreak_;
+        refreshGlobal();
+    }
+
+    // ── accessors ────────────────────────────────────────────────────────────
+    const Vector& vector() const { return vec_; }
+
+    uint16_t hand(int suit)     const { return hand_[suit]; }
+    uint16_t table(int suit)    const { return table_[suit]; }
+    uint16_t playable(int suit) const { return playableMask(table_[suit]) & hand_[suit]; }
+    uint16_t unseen(int suit)   const {
+        return static_cast<uint16_t>(FULL_SUIT & ~hand_[suit] & ~table_[suit]);
+    }
+
+    const std::array<uint16_t, NUM_SUITS>& handMasks()  const { return hand_; }
+    const std::array<uint16_t, NUM_SUITS>& tableMasks() const { return table_; }
+
+    int handSize() const { return handSize_; }
+    int playableCount() const { return playableTotal_; }
+    int tableCount() const { return tableTotal_; }
+    uint64_t passes(uint64_t player) const { return player < MAX_PLAYERS ? seatPasses_[player] : 0; }
+    uint64_t opponentPasses() const { return opponentPasses_; }
+
+private:
+    using Masks = std::array<uint16_t, NUM_SUITS>;
+
+    static Masks masksOf(const std::vector<Card>& hand) {
+        Masks m{};
+        for (const auto& c : hand) m[c.suit] |= bit(c.rank);
+        return m;
+    }
+
+    // Placed cards always form a contiguous run through the 7, so probing
+    // outwards from the 7 is enough.
+    static Masks masksOf(const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table) {
+        Masks m{};
+        for (uint64_t s = 0; s < NUM_SUITS; ++s) {
+            auto it = table.find(s);
+            if (it == table.end()) continue;
+            const auto& ranks = it->second;
+            auto placed = [&ranks](int r) {
+                auto f = ranks.find(static_cast<uint64_t>(r));
+                return f != ranks.end() && f->second;
+            };
+            if (!placed(7)) continue;
+            uint16_t bits = bit(7);
+            for (int r = 6; r >= 1 && placed(r); --r)  bits |= bit(r);
+            for (int r = 8; r <= 13 && placed(r); ++r) bits |= bit(r);
+            m[s] = bits;
+        }
+        return m;
+    }
+
+    static float capped(uint64_t n) { return (n < 30 ? static_cast<float>(n) : 30.0f) / 30.0f; }
+
+    void refreshAll() {
+        for (int s = 0; s < NUM_SUITS; ++s) refreshSuit(s);
+        refreshGlobal();
+    }
+
+    void refreshSuit(int s) {
+        const uint16_t mine   = hand_[s];
+        const uint16_t placed = table_[s];
+        const uint16_t unseen = static_cast<uint16_t>(FULL_SUIT & ~mine & ~placed);
+        const uint16_t low7   = static_cast<uint16_t>(bit(7) - 1);
+        const uint16_t high7  = static_cast<uint16_t>(FULL_SUIT & ~(low7 | bit(7)));
+
+        // Cartes jouables à la suite sans aide extérieure, de chaque côté
+        int runDown = 0, runUp = 0;
+        int lo = placed ? __builtin_ctz(placed) + 1 : 7;
+        int hi = placed ? 16 - __builtin_clz(static_cast<uint32_t>(placed) << 16) : 7;
+        uint16_t reachable = 0;
+        if (!placed && (mine & bit(7))) { reachable |= bit(7); lo = hi = 7; }
+        if (placed || (mine & bit(7))) {
+            for (int r = lo - 1; r >= 1 && (mine & bit(r)); --r) { ++runDown; reachable |= bit(r); }
+            for (int r = hi + 1; r <= 13 && (mine & bit(r)); ++r) { ++runUp; reachable |= bit(r); }
+        }
+        const uint16_t blocked = mine & static_cast<uint16_t>(~reachable);
+
+        // Cartes inconnues entre la table et ma carte la plus éloignée
+        const int myLow  = (mine & low7)  ? __builtin_ctz(mine) + 1 : 7;
+        const int myHigh = (mine & high7) ? 16 - __builtin_clz(static_cast<uint32_t>(mine) << 16) : 7;
+        const uint16_t span = static_cast<uint16_t>(
+            (bit(myHigh) | (bit(myHigh) - 1)) & ~(bit(myLow) - 1));
+        const uint16_t blockers = unseen & span;
+
+        float* f = vec_.v + SUIT_BLOCK * s;
+        f[HAND_COUNT] = static_cast<float>(count(mine)) / 13.0f;
+        f[TABLE_LOW]  = placed ? static_cast<float>(lo) / 13.0f : 0.0f;
+        f[TABLE_HIGH] = placed ? static_cast<float>(hi) / 13.0f : 0.0f;
+        f[OPENED]     = placed ? 1.0f : 0.0f;
+        f[PLAYABLE]   = static_cast<float>(count(playableMask(placed) & mine)) / 2.0f;
+        f[RUN_DOWN]   = static_cast<float>(runDown) / 6.0f;
+        f[RUN_UP]     = static_cast<float>(runUp) / 6.0f;
+        f[BLOCKED]    = static_cast<float>(count(blocked)) / 12.0f;
+        f[UNSEEN]     = static_cast<float>(count(unseen)) / 13.0f;
+        f[BLOCKERS]   = static_cast<float>(count(blockers)) / 12.0f;
+        f[REACH_DOWN] = static_cast<float>(7 - myLow) / 6.0f;
+        f[REACH_UP]   = static_cast<float>(myHigh - 7) / 6.0f;
+    }
+
+    void refreshGlobal() {
+        int handSize = 0, playable = 0, onTable = 0, opened = 0;
+        for (int s = 0; s < NUM_SUITS; ++s) {
+            handSize += count(hand_[s]);
+            playable += count(playableMask(table_[s]) & hand_[s]);
+            onTable  += count(table_[s]);
+            opened   += table_[s] != 0;
+        }
+        handSize_ = handSize;
+        playableTotal_ = playable;
+        tableTotal_ = onTable;
+
+        opponentPasses_ = 0;
+        for (uint64_t p = 0; p < MAX_PLAYERS; ++p)
+            if (p != me_) opponentPasses_ += seatPasses_[p];
+
+        float* g = vec_.v;
+        g[HAND_SIZE]       = static_cast<float>(handSize) / 13.0f;
+        g[PLAYABLE_TOTAL]  = static_cast<float>(playable) / 13.0f;
+        g[TABLE_TOTAL]     = static_cast<float>(onTable) / 52.0f;
+        g[UNSEEN_TOTAL]    = static_cast<float>(52 - handSize - onTable) / 39.0f;
+        g[OPENED_SUITS]    = static_cast<float>(opened) / 4.0f;
+        g[OWN_PASSES]      = capped(passes(me_));
+        g[OPPONENT_PASSES] = capped(opponentPasses_);
+        g[PASS_STREAK]     = static_cast<float>(passStreak_ < MAX_PLAYERS ? passStreak_ : MAX_PLAYERS)
+                           / MAX_PLAYERS;
+        for (int p = 0; p < MAX_PLAYERS; ++p)
+            g[SEAT_PASSES + p] = capped(seatPasses_[p]);
+    }
+
+    uint64_t me_ = 0;
+    Masks    hand_{};
+    Masks    table_{};
+    std::array<uint16_t, MAX_PLAYERS> seatPasses_{};
+    uint64_t passStreak_ = 0;
+    uint64_t opponentPasses_ = 0;
+    int      handSize_ = 0;
+    int      playableTotal_ = 0;
+    int      tableTotal_ = 0;
+    Vector   vec_{};
+};
+
+} // namespace sevens
@@ -1,23 +1,17 @@
 #include "PlayerStrategy.hpp"
+#include "CardId.hpp"
 #include <unordered_map>
 #include <vector>
 #include <chrono>
 #include <random>
 #include <bitset>
-#include <iostream>
 #include <climits>
+#include <memory_resource>
 
 namespace sevens {
 
 // ─── Helpers ─────────────────────────────────────────────────────────────
-static const char* COLORS = "CDHS";  // Clubs, Diamonds, Hearts, Spades
-
-// Convertit un rang numérique en caractère (ex : 1 → 'A', 11 → 'J', etc.)
-static char valueToChar(int value) {
-    if (value == 1) return 'A';
-    if (value >= 2 && value <= 9) return char('0' + value);
-    return "TJQK"[value - 10];
-}
+// (les noms de cartes, ex. "7D", viennent du catalogue constexpr de CardId)
 
 // Donne la valeur d'une carte (As = 14)
 static int cardPower(int value) {
@@ -36,6 +30,16 @@ static bool isPlayable(const Card& card,
     return left || right;
 }
 
+// Même test, en supposant `placed` déjà posée (évite de copier la table)
+static bool isPlayableAfter(const Card& card, const Card& placed,
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table)
+{
+    if (card.suit == placed.suit &&
+        (card.rank == placed.rank - 1 || card.rank == placed.rank + 1))
+        return true;
+    return isPlayable(card, table);
+}
+
 // Vérifie si la carte ouvre une nouvelle couleur (aucune adjacente sur la table)
 static bool opensNewColor(const Card& card,
     const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table)
@@ -65,7 +69,8 @@ public:
         const std::vector<Card>& hand,
         const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& table
     ) override {
-        std::vector<int> playable;
+        // Vecteurs temporaires dans l'arène de la manche (pas de tas)
+        std::pmr::vector<int> playable(scratch());
 
         // 1) Trouver les indices jouables
         for (int i = 0; i < static_cast<int>(hand.size()); ++i)
@@ -75,7 +80,7 @@ public:
         if (playable.empty()) return -1;
 
         // 2) Séparer safe vs risky
-        std::vector<int> safe, risky;
+        std::pmr::vector<int> safe(scratch()), risky(scratch());
         for (int idx : playable) {
             (opensNewColor(hand[idx], table) ? risky : safe).push_back(idx);
         }
@@ -86,27 +91,19 @@ public:
         int bestIdx = playable[0];
         int bestScore = INT_MIN;
 
-        std::cout << "-- SmartSevens scoring --\n";
         for (int idx : playable) {
             const Card& card = hand[idx];
             int score = evaluate(card, hand, table);
-            std::cout << "   [" << valueToChar(card.rank) << COLORS[card.suit]
-                      << "] -> " << score << "\n";
             if (score > bestScore) {
                 bestScore = score;
                 bestIdx = idx;
             }
         }
-
-        const Card& chosen = hand[bestIdx];
-        std::cout << "  -> choosing ["
-                  << valueToChar(chosen.rank) << COLORS[chosen.suit]
-                  << "]\n\n";
         return bestIdx;
     }
 
     void observeMove(uint64_t, const Card& card) override {
-        cardsSeen_.set(cardKey(card));
+        cardsSeen_.set(CardId(card).value);
     }
 
     void observePass(uint64_t playerID) override {
@@ -118,11 +115,6 @@ public:
     }
 
 private:
-    // Calcule un identifiant unique entre 0 et 51 pour une carte
-    static uint64_t cardKey(const Card& card) {
-        return card.suit * 13 + (card.rank - 1);
-    }
-
     // Évalue l'intérêt stratégique de jouer une carte donnée
     int evaluate(const Card& card,
                  const std::vector<Card>& hand,
@@ -140,12 +132,10 @@ private:
 
         // Bonus : cartes de même couleur qui deviendraient jouables après ce coup
         {
-            auto simulatedTable = table;
-            simulatedTable[card.suit][card.rank] = true;
             int future = 0;
             for (const auto& h : hand) {
                 if (h.suit == card.suit && h.rank != card.rank &&
-                    isPlayable(h, simulatedTable)) {
+                    isPlayableAfter(h, card, table)) {
                     future += cardPower(h.rank);
                 }
             }
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CardId.hpp"
+#include "MyGameMapper.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * The engine of MyGameMapper::compute_game_progress with the strategy types
+ * fixed at compile time: seats are a std::array of std::variant<Strategies...>
+ * held by value and every call goes through std::visit, so with final
+ * strategies defined inline (RandomStrategy, GreedyStrategy) the decisions
+ * and notifications are inlined into the round loop.
+ *
+ * Same rules, seat order and deals as MyGameMapper (reseed(seed, g) deals
+ * game g of a seeded series identically); no time control, allocation
+ * counting or scratch arena. For batch runs of built-in strategies.
+ */
+template <class... Strategies>
+class StaticGameEngine {
+public:
+    using Player = std::variant<Strategies...>;
+    static constexpr std::size_t MAX_PLAYERS = 8;
+
+    StaticGameEngine()
+        : rng(static_cast<unsigned long>(
+              std::chrono::system_clock::now().time_since_epoch().count()))
+    {
+        for (uint64_t suit = 0; suit < 4; ++suit)
+            for (uint64_t rank = 0; rank <= 14; ++rank)
+                table_layout[suit][rank] = false;
+    }
+
+    // Ajoute un joueur au siège suivant
+    template <class Strategy, class... Args>
+    Strategy& emplacePlayer(Args&&... args) {
+        if (numPlayers == MAX_PLAYERS)
+            throw std::runtime_error("StaticGameEngine: too many players");
+        return players[numPlayers++].template emplace<Strategy>(std::forward<Args>(args)...);
+    }
+
+    void reseed(uint64_t seed, uint64_t gameIndex) {
+        rng = MyGameMapper::seeded_rng(seed, gameIndex);
+    }
+
+    // Une partie complète (jusqu'à 50 points), résultats par siège
+    std::vector<std::pair<uint64_t, uint64_t>> compute_game_progress(uint64_t /*numPlayers*/) {
+        const std::size_t n = numPlayers;
+        std::array<uint64_t, MAX_PLAYERS> score{};
+        for (std::size_t p = 0; p < n; ++p)
+            std::visit([p](auto& s) { s.initialize(p); }, players[p]);
+
+        std::array<CardId, CardId::NUM_CARDS> deck = FULL_DECK;
+        while (true) {
+            // Donne identique à MyGameMapper : carte i au siège i % n, sauf le 7♦
+            std::shuffle(deck.begin(), deck.end(), rng);
+            for (std::size_t p = 0; p < n; ++p)
+                hands[p].clear();
+            for (std::size_t i = 0; i < deck.size(); ++i)
+                if (deck[i] != SEVEN_OF_DIAMONDS)
+                    hands[i % n].push_back(deck[i].toCard());
+
+            // Table remise à zéro sans réallouer ses nœuds
+            for (auto& suit : table_layout)
+                for (auto& rank : suit.second)
+                    rank.second = false;
+            table_layout[1][7] = true;
+            uint64_t table = SEVEN_OF_DIAMONDS.bit();
+
+            bool anyMove = true;
+            while (anyMove) {
+                anyMove = false;
+                for (std::size_t p = 0; p < n; ++p) {
+                    auto& hand = hands[p];
+                    const int idx = std::visit(
+                        [&](auto& s) { return s.selectCardToPlay(hand, table_layout); }, players[p]);
+
+                    if (idx >= 0 && static_cast<std::size_t>(idx) < hand.size() &&
+                        (card_masks::legal(table) & CardId(hand[idx]).bit())) {
+                        const Card c = hand[idx];
+                        table |= CardId(c).bit();
+                        table_layout[c.suit][c.rank] = true;
+                        hand.erase(hand.begin() + idx);
+                        for (std::size_t q = 0; q < n; ++q)
+                            std::visit([&](auto& s) { s.observeMove(p, c); }, players[q]);
+                        anyMove = true;
+                    } else {
+                        for (std::size_t q = 0; q < n; ++q)
+                            std::visit([&](auto& s) { s.observePass(p); }, players[q]);
+                    }
+                }
+            }
+
+            bool over = false;
+            for (std::size_t p = 0; p < n; ++p) {
+                score[p] += hands[p].size();
+                over = over || score[p] >= 50;
+            }
+            if (over) {
+                std::vector<std::pair<uint64_t, uint64_t>> results;
+                for (std::size_t p = 0; p < n; ++p)
+                    results.emplace_back(p, score[p]);
+                return results;
+            }
+        }
+    }
+
+private:
+    std::array<Player, MAX_PLAYERS>            players{};
+    std::size_t                                numPlayers = 0;
+    std::array<std::vector<Card>, MAX_PLAYERS> hands;
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>> table_layout;
+    std::mt19937                               rng;
+};
+
+} // namespace sevens
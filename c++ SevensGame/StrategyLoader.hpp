@@ -2,7 +2,9 @@
 
 #include "PlayerStrategy.hpp"
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <dlfcn.h>
 #include <stdexcept>
 
@@ -54,4 +56,53 @@ public:
     }
 };
 
+/**
+ * Keeps every plugin opened once for the life of the process, so that a
+ * long-running server creates strategies without going back to dlopen().
+ * Thread-safe; libraries are never closed.
+ */
+class PluginCache {
+public:
+    PluginCache() = default;
+    PluginCache(const PluginCache&) = delete;
+    PluginCache& operator=(const PluginCache&) = delete;
+
+    // New strategy instance from the library at path (opened on first use)
+    std::shared_ptr<PlayerStrategy> create(const std::string& path) {
+        FactoryFn factory = factoryFor(path);
+        PlayerStrategy* raw_ptr = factory();
+        if (!raw_ptr)
+            throw std::runtime_error("createStrategy() returned nullptr in " + path);
+        return std::shared_ptr<PlayerStrategy>(raw_ptr);
+    }
+
+private:
+    using FactoryFn = PlayerStrategy* (*)();
+
+    FactoryFn factoryFor(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = factories.find(path);
+        if (it != factories.end())
+            return it->second;
+
+        void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle)
+            throw std::runtime_error("dlopen failed: " + std::string(dlerror()));
+        dlerror();
+        void* symbol = dlsym(handle, "createStrategy");
+        const char* error = dlerror();
+        if (error || !symbol) {
+            dlclose(handle);
+            throw std::runtime_error("dlsym(createStrategy) failed: " + std::string(error ? error : "<null>"));
+        }
+
+        union { void* ptr; FactoryFn fn; } caster;
+        caster.ptr = symbol;
+        return factories[path] = caster.fn;
+    }
+
+    std::mutex mtx;
+    std::unordered_map<std::string, FactoryFn> factories;
+};
+
 } // namespace sevens
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CardId.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace sevens {
+
+/**
+ * Suit symmetry of Sevens: Clubs, Hearts and Spades play the same role, only
+ * Diamonds is special (the 7♦ opens every round). Positions that differ by a
+ * permutation of those three suits are equivalent, so caches, opening books
+ * or datasets keyed on positions can store one canonical representative and
+ * be up to 6x smaller.
+ *
+ * canonicalize() takes a few card masks (bit = CardId value) describing a
+ * position, e.g. {hand, table} or the hands of a deal, and reorders the
+ * three free suits so that their slices, read mask by mask, are in
+ * decreasing order. Every mask is rewritten in place and the permutation is
+ * returned to map moves (or any other card or mask) back to the real suits.
+ * Shifts, three comparisons and a table lookup, without a branch: about ten
+ * nanoseconds.
+ *
+ * Suits that tie on every mask are interchangeable in that position, so the
+ * tie order does not matter. Histories are mapped card by card with
+ * toCanonical(); to tell apart positions with the same masks but different
+ * histories, pass the history-derived masks (e.g. opponent voids) as well.
+ */
+class SuitPermutation {
+public:
+    static constexpr uint64_t SUIT_BITS = 0x1FFF;
+
+    // Identity: every suit stays in place
+    constexpr SuitPermutation() = default;
+
+    constexpr int toCanonical(int suit) const   { return to_[suit]; }
+    constexpr int fromCanonical(int suit) const { return from_[suit]; }
+
+    constexpr CardId toCanonical(CardId c) const {
+        return CardId(toCanonical(c.suit()), c.rank());
+    }
+    constexpr CardId fromCanonical(CardId c) const {
+        return CardId(fromCanonical(c.suit()), c.rank());
+    }
+
+    constexpr uint64_t toCanonical(uint64_t mask) const   { return permute(mask, to_); }
+    constexpr uint64_t fromCanonical(uint64_t mask) const { return permute(mask, from_); }
+
+    constexpr bool isIdentity() const { return to_[0] == 0 && to_[2] == 2 && to_[3] == 3; }
+
+    // Canonical rank (0..2) of each free suit: 0 → Clubs, 1 → Hearts, 2 → Spades
+    static constexpr SuitPermutation fromRanks(int clubs, int hearts, int spades) {
+        constexpr uint8_t SLOT[3] = {0, 2, 3};
+        SuitPermutation p;
+        p.to_ = {SLOT[clubs], 1, SLOT[hearts], SLOT[spades]};
+        for (int s = 0; s < 4; ++s)
+            p.from_[p.to_[s]] = static_cast<uint8_t>(s);
+        return p;
+    }
+
+private:
+    static constexpr uint64_t slice(uint64_t mask, int suit) {
+        return (mask >> (13 * suit)) & SUIT_BITS;
+    }
+
+    static constexpr uint64_t permute(uint64_t mask, const std::array<uint8_t, 4>& map) {
+        return (mask & card_masks::suit(1))
+             | slice(mask, 0) << (13 * map[0])
+             | slice(mask, 2) << (13 * map[2])
+             | slice(mask, 3) << (13 * map[3]);
+    }
+
+    std::array<uint8_t, 4> to_   = {0, 1, 2, 3};   // vraie couleur → position canonique
+    std::array<uint8_t, 4> from_ = {0, 1, 2, 3};   // position canonique → vraie couleur
+};
+
+namespace suit_tables {
+
+// The six permutations, indexed by rank(Clubs) * 3 + rank(Hearts)
+constexpr std::array<SuitPermutation, 9> makeByRank() {
+    std::array<SuitPermutation, 9> t{};
+    for (int c = 0; c < 3; ++c)
+        for (int h = 0; h < 3; ++h)
+            if (c != h)
+                t[c * 3 + h] = SuitPermutation::fromRanks(c, h, 3 - c - h);
+    return t;
+}
+
+inline constexpr std::array<SuitPermutation, 9> BY_RANK = makeByRank();
+
+} // namespace suit_tables
+
+/**
+ * Rewrites `masks` in canonical suit order and returns the permutation used
+ * (real → canonical). Masks are compared in the order given, the first one
+ * being the most significant.
+ */
+template <std::size_t N>
+SuitPermutation canonicalize(std::array<uint64_t, N>& masks)
+{
+    static_assert(N >= 1, "canonicalize needs at least one mask");
+
+    // Clé d'une couleur : ses tranches de 13 bits, 4 masques par mot
+    constexpr std::size_t WORDS = (N + 3) / 4;
+    using Key = std::array<uint64_t, WORDS>;
+    auto keyOf = [&](int suit) {
+        Key k{};
+        for (std::size_t i = 0; i < N; ++i)
+            k[i / 4] |= ((masks[i] >> (13 * suit)) & SuitPermutation::SUIT_BITS) << (13 * (3 - i % 4));
+        return k;
+    };
+
+    // Jusqu'à 4 masques la clé tient dans un mot : comparaison sans branchement
+    auto less = [](const Key& a, const Key& b) {
+        if constexpr (WORDS == 1) return a[0] < b[0];
+        else                      return a < b;
+    };
+
+    // Rang de chaque couleur dans l'ordre décroissant ;
+    // à égalité la couleur d'indice le plus bas passe devant
+    const Key c = keyOf(0), h = keyOf(2), s = keyOf(3);
+    const int rc = less(c, h) + less(c, s);
+    const int rh = !less(c, h) + less(h, s);
+
+    const SuitPermutation& perm = suit_tables::BY_RANK[rc * 3 + rh];
+    for (auto& m : masks)
+        m = perm.toCanonical(m);
+    return perm;
+}
+
+// The usual case: the player's hand and the table
+inline SuitPermutation canonicalize(uint64_t& hand, uint64_t& table)
+{
+    std::array<uint64_t, 2> masks = {hand, table};
+    const SuitPermutation perm = canonicalize(masks);
+    hand  = masks[0];
+    table = masks[1];
+    return perm;
+}
+
+} // namespace sevens
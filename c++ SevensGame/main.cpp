@@ -4,9 +4,23 @@
 #include <memory>
 #include <algorithm>
 #include <unordered_map>
-
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include "Checkpoint.hpp"
+#include "DealAnalyzer.hpp"
+#include "DecisionLog.hpp"
+#include "MatchServer.hpp"
 #include "MyGameMapper.hpp"
+#include "Perft.hpp"
 #include "RandomStrategy.hpp"
+#include "ReplayDiff.hpp"
+#include "SelfTest.hpp"
+#include "StaticGameEngine.hpp"
 #include "GreedyStrategy.hpp"
 #include "StrategyLoader.hpp"
 #include "PlayerStrategy.hpp"
@@ -19,143 +33,694 @@ static void usage(const char* bin)
     std::cerr << "Usage:\n"
               << "  " << bin << " internal\n"
               << "  " << bin << " demo\n"
-              << "  " << bin << " competition lib1.so [lib2.so …]\n";
+              << "  " << bin << " competition lib1.so [lib2.so …]\n"
+              << "Series options (any mode):\n"
+              << "  --games N             play N independent games and report totals\n"
+              << "  --seed S              seed of the series (default: clock)\n"
+              << "  --checkpoint FILE     save progress to FILE periodically\n"
+              << "  --checkpoint-every K  games between two saves (default 10)\n"
+              << "  --resume              continue the series saved in --checkpoint\n"
+              << "  --count-allocs        report heap allocations per decision and player\n"
+              << "  --move-time MS        time limit per decision, enforced by a watchdog\n"
+              << "  --game-bank MS        time bank per player and per game\n"
+              << "  --dynamic             internal/demo series: use the virtual-call engine\n"
+              << "  --ponder              let strategies that ask for it think on other players' turns\n"
+              << "  " << bin << " perft [--seed S] [--players N] [--depth D] [--threads T] [--tt MB] [--divide]\n"
+              << "      count the legal move sequences of the first deal of game 0 of seed S,\n"
+              << "      for every depth up to D (default 8)\n"
+              << "  " << bin << " serve SOCKET [--threads T] [--move-time MS | --game-bank MS]\n"
+              << "      match server on a Unix domain socket (protocol in MatchServer.hpp)\n"
+              << "  " << bin << " analyze lib1.so lib2.so [...] [--seed S | --deal \"7C 8C/2D .../...\"]\n"
+              << "          [--samples N] [--threads T]\n"
+              << "      replay one deal N times (default 2000) per line: cards left and win\n"
+              << "      probability per seat, overall and for each first move of seat 0\n"
+              << "  " << bin << " competition ... --record FILE   log every deal and decision to FILE\n"
+              << "      (whole series only: not with --resume)\n"
+              << "  " << bin << " replay-diff FILE build.so [other_build.so] [--threads T] [--all-seats] [--show N]\n"
+              << "      replay the logged decisions on one build (vs the log) or two (vs each other)\n"
+              << "  " << bin << " selftest [--seed S] [--games N]\n"
+              << "      check the strategy helpers against N seeded rounds per seat count (default 300)\n";
 }
 
-/* --------------------------------------------------------------------- */
-int main(int argc, char* argv[])
+// Options communes à tous les modes (séries de parties, reprise)
+struct RunOptions {
+    uint64_t    games           = 0;   // 0 = une seule partie, affichage classique
+    uint64_t    seed            = 0;
+    bool        hasSeed         = false;
+    std::string checkpoint;
+    uint64_t    checkpointEvery = 10;
+    bool        resume          = false;
+    bool        countAllocs     = false;
+    bool        dynamic         = false;
+    bool        ponder          = false;
+    MyGameMapper::TimeControl timeControl;
+
+    // Mode perft
+    uint64_t    players         = 4;
+    int         depth           = 8;
+    unsigned    threads         = 0;   // 0 = tous les cœurs
+    uint64_t    ttMiB           = 0;
+    bool        divide          = false;
+
+    // Enregistrement (competition) et replay-diff
+    std::string record;
+    bool        allSeats        = false;
+    uint64_t    show            = 20;
+
+    // Mode analyze
+    std::string deal;
+    uint64_t    samples         = 2000;
+
+    bool series() const { return games > 0 || !checkpoint.empty() || resume; }
+
+    // Séries de stratégies internes : moteur statique sauf option qui l'exclut
+    bool staticEngine() const {
+        return series() && !dynamic && !countAllocs && !ponder
+            && timeControl.mode == MyGameMapper::TimeControl::NONE;
+    }
+};
+
+// Sépare les options "--xxx" des arguments positionnels (bibliothèques .so)
+static RunOptions parse_options(int argc, char* argv[], std::vector<std::string>& positional)
 {
-    // Vérification du nombre d'arguments
-    if (argc < 2) {
-        usage(argv[0]);
+    RunOptions opt;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument(arg + " expects a value");
+            return argv[++i];
+        };
+
+        if      (arg == "--games")            opt.games = std::stoull(value());
+        else if (arg == "--seed")             { opt.seed = std::stoull(value()); opt.hasSeed = true; }
+        else if (arg == "--checkpoint")       opt.checkpoint = value();
+        else if (arg == "--checkpoint-every") opt.checkpointEvery = std::stoull(value());
+        else if (arg == "--resume")           opt.resume = true;
+        else if (arg == "--count-allocs")     opt.countAllocs = true;
+        else if (arg == "--dynamic")          opt.dynamic = true;
+        else if (arg == "--ponder")           opt.ponder = true;
+        else if (arg == "--move-time" || arg == "--game-bank") {
+            const double ms = std::stod(value());
+            if (ms <= 0)
+                throw std::invalid_argument(arg + " expects a positive duration");
+            opt.timeControl.mode = arg == "--move-time" ? MyGameMapper::TimeControl::PER_MOVE
+                                                        : MyGameMapper::TimeControl::GAME_BANK;
+            opt.timeControl.budget = std::chrono::microseconds(static_cast<int64_t>(ms * 1000));
+        }
+        else if (arg == "--players")          opt.players = std::stoull(value());
+        else if (arg == "--depth")            opt.depth = std::stoi(value());
+        else if (arg == "--threads")          opt.threads = static_cast<unsigned>(std::stoul(value()));
+        else if (arg == "--tt")               opt.ttMiB = std::stoull(value());
+        else if (arg == "--divide")           opt.divide = true;
+        else if (arg == "--deal")             opt.deal = value();
+        else if (arg == "--samples")          opt.samples = std::stoull(value());
+        else if (arg == "--record")           opt.record = value();
+        else if (arg == "--all-seats")        opt.allSeats = true;
+        else if (arg == "--show")             opt.show = std::stoull(value());
+        else if (arg.rfind("--", 0) == 0)     throw std::invalid_argument("unknown option " + arg);
+        else                                  positional.push_back(arg);
+    }
+    if (opt.resume && opt.checkpoint.empty())
+        throw std::invalid_argument("--resume requires --checkpoint FILE");
+    if (opt.resume && !opt.record.empty())   // le journal doit couvrir la série depuis la partie 0
+        throw std::invalid_argument("--record cannot be combined with --resume: "
+                                    "a decision log must cover the whole series from game 0");
+    if (opt.checkpointEvery == 0)
+        opt.checkpointEvery = 1;
+    return opt;
+}
+
+// Statistiques par décision : dépassements de temps, allocations (--count-allocs)
+static void report_decisions(const MyGameMapper& mapper,
+                               const std::vector<std::string>& pname,
+                               const RunOptions& opt)
+{
+    if (opt.timeControl.mode != MyGameMapper::TimeControl::NONE) {
+        std::cout << "\n[main] Decisions cut by the time control:\n";
+        for (std::size_t pid = 0; pid < pname.size(); ++pid) {
+            auto it = mapper.decision_timeouts().find(pid);
+            std::cout << "  " << pname[pid] << " -> "
+                      << (it == mapper.decision_timeouts().end() ? 0 : it->second) << '\n';
+        }
+    }
+
+    if (opt.ponder) {
+        std::cout << "\n[main] Ponder runs (background thinking on others' turns):\n";
+        for (std::size_t pid = 0; pid < pname.size(); ++pid)
+            std::cout << "  " << pname[pid] << " -> " << mapper.ponder_runs(pid) << '\n';
+    }
+
+    if (!opt.countAllocs)
+        return;
+    std::cout << "\n[main] Heap allocations per decision:\n";
+    for (const auto& [pid, st] : mapper.decision_allocs()) {
+        const double n = st.decisions ? static_cast<double>(st.decisions) : 1.0;
+        std::cout << "  " << pname[pid] << " -> " << st.allocations / n << " allocs, "
+                  << st.bytes / n << " bytes (" << st.decisions << " decisions)\n";
+    }
+}
+
+// Joue une série de parties indépendantes, avec points de reprise éventuels
+// (Engine : MyGameMapper, ou StaticGameEngine pour les stratégies internes)
+template <class Engine>
+static int run_series(Engine& mapper,
+                      const std::vector<std::string>& pname,
+                      const RunOptions& opt)
+{
+    TournamentCheckpoint cp;
+
+    if (opt.resume) {
+        cp = TournamentCheckpoint::load(opt.checkpoint);
+        bool sameSeats = cp.tallies.size() == pname.size();
+        for (std::size_t i = 0; sameSeats && i < pname.size(); ++i)
+            sameSeats = cp.tallies[i].name == pname[i];
+        if (!sameSeats) {
+            std::cerr << "Checkpoint " << opt.checkpoint
+                      << " was written for a different set of players\n";
+            return 1;
+        }
+        if (opt.games > 0)
+            cp.gamesTotal = opt.games;
+        std::cout << "[main] Resuming at game " << cp.gamesDone
+                  << '/' << cp.gamesTotal << " (seed " << cp.seed << ")\n";
+    } else {
+        cp.seed = opt.hasSeed
+            ? opt.seed
+            : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        cp.gamesTotal = opt.games > 0 ? opt.games : 1;
+        for (const auto& name : pname)
+            cp.tallies.push_back(PlayerTally{name});
+        std::cout << "[main] Series of " << cp.gamesTotal
+                  << " games (seed " << cp.seed << ")\n";
+    }
+
+    while (cp.gamesDone < cp.gamesTotal) {
+        mapper.reseed(cp.seed, cp.gamesDone);
+        auto res = mapper.compute_game_progress(pname.size());
+
+        uint64_t best = UINT64_MAX;
+        for (auto& p : res)
+            best = std::min(best, p.second);
+        for (auto& p : res) {
+            auto& t = cp.tallies[p.first];
+            ++t.games;
+            t.points += p.second;
+            if (p.second == best) ++t.wins;
+        }
+
+        ++cp.gamesDone;
+        if (!opt.checkpoint.empty() &&
+            (cp.gamesDone % opt.checkpointEvery == 0 || cp.gamesDone == cp.gamesTotal))
+            cp.save(opt.checkpoint);
+    }
+
+    // Classement par moyenne de points croissante
+    std::vector<PlayerTally> ranking = cp.tallies;
+    std::sort(ranking.begin(), ranking.end(), [](const auto& a, const auto& b) {
+        return a.points * b.games < b.points * a.games;
+    });
+
+    std::cout << "\n[main] Series results after " << cp.gamesDone
+              << " games (lower avg pts = better):\n";
+    for (const auto& t : ranking) {
+        const double avg = t.games ? static_cast<double>(t.points) / t.games : 0.0;
+        std::cout << "  " << t.name << " -> " << t.wins << " wins, "
+                  << avg << " avg pts\n";
+    }
+    if constexpr (std::is_same_v<Engine, MyGameMapper>)
+        report_decisions(mapper, pname, opt);
+    return 0;
+}
+
+// Énumère les séquences de coups de la première donne, profondeur par profondeur
+static int run_perft(const RunOptions& opt)
+{
+    if (opt.players < 2 || opt.players > RoundState::MAX_PLAYERS) {
+        std::cerr << "perft needs 2 to " << RoundState::MAX_PLAYERS << " players\n";
         return 1;
     }
+    const uint64_t seed = opt.hasSeed
+        ? opt.seed
+        : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+
+    auto rng = MyGameMapper::seeded_rng(seed, 0);
+    const RoundState start = RoundState::deal(rng, static_cast<int>(opt.players));
+
+    PerftOptions po;
+    po.threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    po.ttBytes = opt.ttMiB << 20;
+
+    std::cout << "[perft] seed " << seed << ", " << opt.players << " players, "
+              << po.threads << " threads, TT " << opt.ttMiB << " MiB\n";
+    for (uint64_t p = 0; p < opt.players; ++p) {
+        std::cout << "  P" << p << ':';
+        for (RoundState::Mask h = start.hand(static_cast<int>(p)); h; h &= h - 1)
+            std::cout << ' ' << CardId(static_cast<uint8_t>(__builtin_ctzll(h)));
+        std::cout << '\n';
+    }
 
-    const std::string mode = argv[1];
-    MyGameMapper mapper;
+    std::cout << "\n  depth            nodes   ended rounds      time   Mnodes/s\n";
+    PerftResult res;
+    for (int d = 1; d <= opt.depth; ++d) {
+        po.depth = d;
+        const auto t0 = std::chrono::steady_clock::now();
+        res = perft(start, po);
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "  " << std::setw(5) << d << std::setw(17) << res.nodes
+                  << std::setw(15) << res.ended << std::setw(9) << std::fixed
+                  << std::setprecision(3) << s << 's' << std::setw(11) << std::setprecision(1)
+                  << (s > 0 ? (res.nodes + res.ended) / s / 1e6 : 0.0) << '\n';
+    }
 
-    // Chargement initial du paquet et de la table
-    mapper.read_cards("");
-    mapper.read_game("");
+    if (opt.divide) {
+        std::cout << "\n[perft] divide at depth " << opt.depth << ":\n";
+        for (const auto& r : res.roots)
+            std::cout << "  " << (r.move ? CardId(static_cast<uint8_t>(__builtin_ctzll(r.move))).name() : "pass")
+                      << ": " << r.nodes << " (" << r.ended << " ended)\n";
+    }
+    return 0;
+}
 
-    /* -------------------- MODE INTERNAL ------------------------------ */
-    if (mode == "internal")
-    {
-        std::vector<std::string> pname;
+// Affiche une ligne de résultats par siège (intervalles à 95 %)
+static void print_outcomes(const std::vector<SeatOutcome>& seats,
+                           const std::vector<std::string>& pname)
+{
+    for (std::size_t s = 0; s < seats.size(); ++s) {
+        const auto& o = seats[s];
+        std::cout << "    " << std::left << std::setw(24) << pname[s] << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(6) << o.meanLeft << " ± " << std::setw(4) << o.leftError << " cards   win "
+                  << std::setprecision(1) << std::setw(5) << 100 * o.winProb << "% ["
+                  << 100 * o.winLow << ", " << 100 * o.winHigh << "]\n";
+    }
+}
 
-        // Tous les joueurs utilisent la stratégie Random
-        for (int pid = 0; pid < 4; ++pid)
-        {
-            auto s = std::make_shared<RandomStrategy>();
-            mapper.registerStrategy(pid, s);
-            pname.push_back(s->getName() + '-' + std::to_string(pid));
+// Rejoue une donne (graine ou --deal) avec les stratégies chargées
+static int run_analyze(const std::vector<std::string>& libs, const RunOptions& opt)
+{
+    if (libs.size() < 2 || libs.size() > RoundState::MAX_PLAYERS) {
+        std::cerr << "analyze needs 2 to " << RoundState::MAX_PLAYERS << " strategy libraries\n";
+        return 1;
+    }
+
+    std::vector<std::vector<Card>> hands;
+    if (!opt.deal.empty()) {
+        hands = parse_deal(opt.deal);
+        if (hands.size() != libs.size()) {
+            std::cerr << "the deal has " << hands.size() << " seats but "
+                      << libs.size() << " strategies were given\n";
+            return 1;
         }
+    } else {
+        const uint64_t seed = opt.hasSeed
+            ? opt.seed
+            : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        auto rng = MyGameMapper::seeded_rng(seed, 0);
+        const RoundState start = RoundState::deal(rng, static_cast<int>(libs.size()));
+        hands.resize(libs.size());
+        for (std::size_t p = 0; p < libs.size(); ++p)
+            for (RoundState::Mask h = start.hand(static_cast<int>(p)); h; h &= h - 1)
+                hands[p].push_back(CardId(static_cast<uint8_t>(__builtin_ctzll(h))).toCard());
+        std::cout << "[analyze] First deal of seed " << seed << '\n';
+    }
 
-        std::cout << "[main] Running INTERNAL :\n";
-        for (std::size_t i = 0; i < pname.size(); ++i)
-            std::cout << "  P" << i << " → " << pname[i] << '\n';
+    PluginCache plugins;
+    std::vector<std::string> pname;
+    for (std::size_t i = 0; i < libs.size(); ++i)
+        pname.push_back(plugins.create(libs[i])->getName() + '-' + std::to_string(i));
+    for (std::size_t p = 0; p < hands.size(); ++p) {
+        std::cout << "  P" << p << ':';
+        for (const auto& c : hands[p])
+            std::cout << ' ' << CardId(c);
+        std::cout << '\n';
+    }
 
-        auto res = mapper.compute_and_display_game(4);
+    const unsigned threads = opt.threads ? opt.threads
+                                         : std::max(1u, std::thread::hardware_concurrency());
+    const auto t0 = std::chrono::steady_clock::now();
+    const DealAnalysis res = analyze_deal(
+        hands, [&](std::size_t seat) { return plugins.create(libs[seat]); }, opt.samples, threads);
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "\n[analyze] " << res.samples << " replays per line, " << threads
+              << " threads, " << std::setprecision(3) << secs << "s\n  free play:\n";
+    print_outcomes(res.seats, pname);
+    for (const auto& op : res.openings) {
+        std::cout << "  " << pname[0] << " opens " << CardId(op.card) << ":\n";
+        print_outcomes(op.seats, pname);
+    }
+    return 0;
+}
 
-        std::cout << "\n[main] Results (lower pts = better):\n";
-        std::sort(res.begin(), res.end(),
-                  [](auto& a, auto& b){ return a.second < b.second; });
-        for (auto& p : res)
-            std::cout << "  " << pname[p.first] << " -> "
-                      << p.second << " pts\n";
+// Carte (identifiant) ou passe (-1)
+static std::string action_name(int card)
+{
+    return card < 0 ? "pass" : CardId(static_cast<uint8_t>(card)).name();
+}
 
-        return 0;
+// Compare une ou deux versions d'une stratégie sur les décisions enregistrées
+static int run_replay_diff(const std::vector<std::string>& args, const RunOptions& opt)
+{
+    if (args.size() < 2 || args.size() > 3) {
+        std::cerr << "replay-diff needs a decision log and one or two builds\n";
+        return 1;
     }
+    const DecisionLog log = DecisionLog::load(args[0]);
+
+    ReplayOptions ro;
+    ro.builds.assign(args.begin() + 1, args.end());
+    ro.threads  = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    ro.allSeats = opt.allSeats;
+    ro.maxShown = opt.show;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const ReplayReport rep = replay_diff(log, ro);
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "[replay-diff] " << log.games.size() << " games, " << rep.decisions
+              << " decisions replayed on seats";
+    for (auto s : rep.seats)
+        std::cout << ' ' << s << " (" << log.seatNames[s] << ')';
+    std::cout << ", " << ro.threads << " threads, " << secs << "s\n";
+
+    for (std::size_t b = 0; b < rep.builds.size(); ++b) {
+        const auto& st = rep.builds[b];
+        const double n = rep.decisions ? static_cast<double>(rep.decisions) : 1.0;
+        std::cout << "  " << char('A' + b) << ' ' << ro.builds[b] << " (" << st.name << "): "
+                  << st.totalNs / n / 1000 << " us/decision, max " << st.maxNs / 1000
+                  << " us, " << st.offRecord << " differ from the log\n";
+    }
+    std::cout << "  " << rep.differences << " differing decisions"
+              << (rep.builds.size() == 2 ? " between A and B\n" : "\n");
+
+    for (const auto& d : rep.shown) {
+        std::cout << "    game " << d.game << " round " << d.round << " seat " << d.seat << " hand";
+        for (const auto& c : d.hand)
+            std::cout << ' ' << CardId(c);
+        std::cout << " | table";
+        for (uint64_t t = d.table; t; t &= t - 1)
+            std::cout << ' ' << CardId(static_cast<uint8_t>(__builtin_ctzll(t)));
+        std::cout << " | log " << action_name(d.recorded) << ", A " << action_name(d.answers[0]);
+        if (rep.builds.size() == 2)
+            std::cout << ", B " << action_name(d.answers[1]);
+        std::cout << '\n';
+    }
+    return 0;
+}
 
-    /* -------------------- MODE DEMO ---------------------------------- */
-    if (mode == "demo")
+// Contrôles de cohérence des aides aux stratégies ; 1 si l'un échoue
+static int run_selftest(const RunOptions& opt)
+{
+    const uint64_t seed   = opt.hasSeed ? opt.seed : 1;
+    const uint64_t rounds = opt.games > 0 ? opt.games : 300;
+    std::cout << "[selftest] seed " << seed << ", " << rounds << " rounds per seat count\n";
+
+    int status = 0;
+    for (const auto& r : run_self_tests(seed, rounds)) {
+        std::cout << "  " << std::left << std::setw(10) << r.name << std::right
+                  << std::setw(12) << r.checks << " checks, " << r.failures << " failed\n";
+        if (r.failures) {
+            std::cout << "    first: " << r.firstFailure << '\n';
+            status = 1;
+        }
+    }
+    return status;
+}
+
+// Mode internal : quatre stratégies Random intégrées
+static int run_internal(MyGameMapper& mapper, const RunOptions& opt)
+{
+    std::vector<std::string> pname;
+
+    // Tous les joueurs utilisent la stratégie Random
+    for (int pid = 0; pid < 4; ++pid)
     {
-        std::vector<std::string> pname;
+        auto s = std::make_shared<RandomStrategy>();
+        mapper.registerStrategy(pid, s);
+        pname.push_back(s->getName() + '-' + std::to_string(pid));
+    }
+
+    std::cout << "[main] Running INTERNAL :\n";
+    for (std::size_t i = 0; i < pname.size(); ++i)
+        std::cout << "  P" << i << " → " << pname[i] << '\n';
 
-        // 2 joueurs Random, 2 joueurs Greedy
+    if (opt.staticEngine()) {
+        StaticGameEngine<RandomStrategy> engine;
         for (int pid = 0; pid < 4; ++pid)
-        {
-            std::shared_ptr<PlayerStrategy> s;
+            engine.emplacePlayer<RandomStrategy>();
+        return run_series(engine, pname, opt);
+    }
+    if (opt.series())
+        return run_series(mapper, pname, opt);
+
+    auto res = mapper.compute_and_display_game(4);
+
+    std::cout << "\n[main] Results (lower pts = better):\n";
+    std::sort(res.begin(), res.end(),
+              [](auto& a, auto& b){ return a.second < b.second; });
+    for (auto& p : res)
+        std::cout << "  " << pname[p.first] << " -> "
+                  << p.second << " pts\n";
+
+    report_decisions(mapper, pname, opt);
+    return 0;
+}
+
+// Mode demo : deux Random et deux Greedy intégrées
+static int run_demo(MyGameMapper& mapper, const RunOptions& opt)
+{
+    std::vector<std::string> pname;
+
+    // 2 joueurs Random, 2 joueurs Greedy
+    for (int pid = 0; pid < 4; ++pid)
+    {
+        std::shared_ptr<PlayerStrategy> s;
+        if (pid < 2)
+            s = std::make_shared<RandomStrategy>();
+        else
+            s = std::make_shared<GreedyStrategy>();
+
+        mapper.registerStrategy(pid, s);
+        pname.push_back(s->getName() + '-' + std::to_string(pid));
+    }
+
+    std::cout << "[main] Running DEMO :\n";
+    for (std::size_t i = 0; i < pname.size(); ++i)
+        std::cout << "  P" << i << " → " << pname[i] << '\n';
+
+    if (opt.staticEngine()) {
+        StaticGameEngine<RandomStrategy, GreedyStrategy> engine;
+        for (int pid = 0; pid < 4; ++pid) {
             if (pid < 2)
-                s = std::make_shared<RandomStrategy>();
+                engine.emplacePlayer<RandomStrategy>();
             else
-                s = std::make_shared<GreedyStrategy>();
-
-            mapper.registerStrategy(pid, s);
-            pname.push_back(s->getName() + '-' + std::to_string(pid));
+                engine.emplacePlayer<GreedyStrategy>();
         }
+        return run_series(engine, pname, opt);
+    }
+    if (opt.series())
+        return run_series(mapper, pname, opt);
 
-        std::cout << "[main] Running DEMO :\n";
-        for (std::size_t i = 0; i < pname.size(); ++i)
-            std::cout << "  P" << i << " → " << pname[i] << '\n';
+    auto res = mapper.compute_and_display_game(4);
 
-        auto res = mapper.compute_and_display_game(4);
+    std::cout << "\n[main] Results (lower pts = better):\n";
+    std::sort(res.begin(), res.end(),
+              [](auto& a, auto& b){ return a.second < b.second; });
+    for (auto& p : res)
+        std::cout << "  " << pname[p.first] << " -> "
+                  << p.second << " pts\n";
 
-        std::cout << "\n[main] Results (lower pts = better):\n";
-        std::sort(res.begin(), res.end(),
-                  [](auto& a, auto& b){ return a.second < b.second; });
-        for (auto& p : res)
-            std::cout << "  " << pname[p.first] << " -> "
-                      << p.second << " pts\n";
+    report_decisions(mapper, pname, opt);
+    return 0;
+}
+
+// Mode competition : une stratégie chargée dynamiquement par siège
+static int run_competition(MyGameMapper& mapper, const std::vector<std::string>& args,
+                           const RunOptions& opt)
+{
+    std::vector<std::string> pname;
+    std::vector<std::string> recordedNames;
 
-        return 0;
+    // Chargement dynamique des .so
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        const std::string& lib = args[i];
+        std::cout << "Loading strategy from " << lib << "...\n";
+
+        auto s = StrategyLoader::load_from_library(lib);
+        const std::string label = s->getName() + '-' + std::to_string(i);
+
+        std::cout << "Registered " << label << " successfully.\n";
+
+        mapper.registerStrategy(i, s);
+        pname.push_back(label);
+        recordedNames.push_back(s->getName());
     }
 
-    /* -------------------- MODE COMPETITION --------------------------- */
-    if (mode == "competition")
+    // Journal des décisions pour replay-diff
+    std::unique_ptr<DecisionRecorder> recorder;
+    if (!opt.record.empty()) {
+        recorder = std::make_unique<DecisionRecorder>(opt.record, recordedNames);
+        mapper.setRecorder(recorder.get());
+    }
+
+    std::cout << "\nStarting competition with " << pname.size() << " players...\n";
+
+    if (opt.series())
+        return run_series(mapper, pname, opt);
+
+    auto res = mapper.compute_and_display_game(pname.size());
+
+    // Trie les résultats selon les scores croissants
+    std::vector<std::pair<uint64_t, uint64_t>> sorted_res = res;
+    std::sort(sorted_res.begin(), sorted_res.end(),
+              [](const auto& a, const auto& b) { return a.second < b.second; });
+
+    // Attribue les rangs à chaque joueur
+    std::unordered_map<int, int> pid_to_rank;
+    for (size_t rank = 0; rank < sorted_res.size(); ++rank) {
+        pid_to_rank[sorted_res[rank].first] = static_cast<int>(rank + 1);
+    }
+
+    // Affiche le classement final (propre)
+    std::cout << "\n[MyGameMapper] Final Rankings:\n";
+    for (const auto& [pid, score] : sorted_res) {
+        std::cout << "  " << pname[pid] << " -> Rank " << pid_to_rank[pid] << "\n";
+    }
+
+    // Affiche le résumé final lisible
+    std::cout << "\n[main] Competition Results:\n";
+    for (size_t i = 0; i < pname.size(); ++i) {
+        std::cout << "  " << pname[i]
+                  << " -> Final Rank " << pid_to_rank[i] << "\n";
+    }
+
+    report_decisions(mapper, pname, opt);
+    return 0;
+}
+
+/* --------------------------------------------------------------------- */
+int main(int argc, char* argv[])
+{
+    // Vérification du nombre d'arguments
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const std::string mode = argv[1];
+    MyGameMapper mapper;
+
+    std::vector<std::string> args;
+    RunOptions opt;
+    try {
+        opt = parse_options(argc, argv, args);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        usage(argv[0]);
+        return 1;
+    }
+    /* -------------------- MODE PERFT ---------------------------------- */
+    if (mode == "perft")
     {
-        // Vérifie que des stratégies ont été passées en arguments
-        if (argc < 3) {
-            usage(argv[0]);
+        try {
+            return run_perft(opt);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
             return 1;
         }
+    }
 
-        std::vector<std::string> pname;
-
-        // Chargement dynamique des .so
-        for (int i = 2; i < argc; ++i)
-        {
-            const std::string lib = argv[i];
-            std::cout << "Loading strategy from " << lib << "...\n";
-
-            auto s = StrategyLoader::load_from_library(lib);
-            const std::string label = s->getName() + '-' + std::to_string(i - 2);
+    /* -------------------- MODE SERVE ---------------------------------- */
+    if (mode == "serve")
+    {
+        if (args.size() != 1) {
+            usage(argv[0]);
+            return 1;
+        }
+        try {
+            const unsigned workers = opt.threads ? opt.threads
+                                                 : std::max(1u, std::thread::hardware_concurrency());
+            MatchServer server(args[0], workers, opt.timeControl);
+            server.run();
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
 
-            std::cout << "Registered " << label << " successfully.\n";
+    /* -------------------- MODE ANALYZE -------------------------------- */
+    if (mode == "analyze")
+    {
+        try {
+            return run_analyze(args, opt);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
 
-            mapper.registerStrategy(i - 2, s);
-            pname.push_back(label);
+    /* -------------------- MODE REPLAY-DIFF ---------------------------- */
+    if (mode == "replay-diff")
+    {
+        try {
+            return run_replay_diff(args, opt);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
         }
+    }
 
-        std::cout << "\nStarting competition with " << pname.size() << " players...\n";
+    /* -------------------- MODE SELFTEST ------------------------------- */
+    if (mode == "selftest")
+        return run_selftest(opt);
 
-        auto res = mapper.compute_and_display_game(pname.size());
+    mapper.setCountAllocations(opt.countAllocs);
+    mapper.setTimeControl(opt.timeControl);
+    mapper.setPondering(opt.ponder);
 
-        // Trie les résultats selon les scores croissants
-        std::vector<std::pair<uint64_t, uint64_t>> sorted_res = res;
-        std::sort(sorted_res.begin(), sorted_res.end(),
-                  [](const auto& a, const auto& b) { return a.second < b.second; });
+    // Chargement initial du paquet et de la table
+    mapper.read_cards("");
+    mapper.read_game("");
 
-        // Attribue les rangs à chaque joueur
-        std::unordered_map<int, int> pid_to_rank;
-        for (size_t rank = 0; rank < sorted_res.size(); ++rank) {
-            pid_to_rank[sorted_res[rank].first] = static_cast<int>(rank + 1);
+    /* -------------------- MODE INTERNAL ------------------------------ */
+    if (mode == "internal")
+    {
+        try {
+            return run_internal(mapper, opt);
+        } catch (const std::exception& e) {   // point de reprise, journal, plugin…
+            std::cerr << e.what() << '\n';
+            return 1;
         }
+    }
 
-        // Affiche le classement final (propre)
-        std::cout << "\n[MyGameMapper] Final Rankings:\n";
-        for (const auto& [pid, score] : sorted_res) {
-            std::cout << "  " << pname[pid] << " -> Rank " << pid_to_rank[pid] << "\n";
+    /* -------------------- MODE DEMO ---------------------------------- */
+    if (mode == "demo")
+    {
+        try {
+            return run_demo(mapper, opt);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
         }
+    }
 
-        // Affiche le résumé final lisible
-        std::cout << "\n[main] Competition Results:\n";
-        for (size_t i = 0; i < pname.size(); ++i) {
-            std::cout << "  " << pname[i]
-                      << " -> Final Rank " << pid_to_rank[i] << "\n";
+    /* -------------------- MODE COMPETITION --------------------------- */
+    if (mode == "competition")
+    {
+        // Vérifie que des stratégies ont été passées en arguments
+        if (args.empty()) {
+            usage(argv[0]);
+            return 1;
+        }
+        try {
+            return run_competition(mapper, args, opt);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
         }
-
-        return 0;
     }
 
     // Mode inconnu